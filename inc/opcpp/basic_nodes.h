@@ -26,7 +26,27 @@ class TerminalNode : public opNode {
    public:
     DECLARE_NODE(TerminalNode, opNode, T_UNKNOWN);
 
-    void CloneNode(TerminalNode* newnode) { newnode->value = value; }
+    void Init() {
+        text = "";
+        length = 0;
+        bOwnsValue = false;
+    }
+
+    // clones own their text, they may outlive the scanned file (interned
+    // text lives for the whole run, so they can view that instead)
+    void CloneNode(TerminalNode* newnode) {
+        newnode->symbol = symbol;
+
+        if (!symbol.IsNull()) {
+            const opString& interned = symbol.GetString();
+
+            newnode->text = interned.GetCString();
+            newnode->length = interned.Length();
+            return;
+        }
+
+        newnode->CopyText(GetText(), length);
+    }
 
     // construction / destruction
     // validated construction from scanner
@@ -35,40 +55,59 @@ class TerminalNode : public opNode {
         SetLine(t.Line);
         SetFile(infile);
 
-        value = t.Value;
+        bOwnsValue = false;
 
         // terminals whose printed value differs from their recognized value
+        const char* printed = NULL;
+
         if (t.Id == T_SPACER)
-            value = "";
+            printed = "";
         else if (t.Id == T_SPECIAL_LEFT_BRACE)
-            value = "{";
+            printed = "{";
         else if (t.Id == T_SPECIAL_RIGHT_BRACE)
-            value = "}";
+            printed = "}";
         else if (t.Id == T_SPECIAL_LEFT_PAREN)
-            value = "(";
+            printed = "(";
         else if (t.Id == T_SPECIAL_RIGHT_PAREN)
-            value = ")";
+            printed = ")";
         else if (t.Id == T_SPECIAL_LEFT_BRACKET)
-            value = "[";
+            printed = "[";
         else if (t.Id == T_SPECIAL_RIGHT_BRACKET)
-            value = "]";
+            printed = "]";
         else if (t.Id == T_ACCENT)
-            value = "'";
+            printed = "'";
         else if (t.Id == T_DOUBLE_ACCENT)
-            value = "\"";
+            printed = "\"";
+
+        if (printed) {
+            text = printed;
+            length = (int)strlen(printed);
+            return;
+        }
+
+        // scanned text stays in the file buffer until it's asked for
+        text = t.Text;
+        length = t.Length;
+        symbol = t.Symbol;
+
+        if (!text) CopyText(t.Value.GetCString(), t.Value.Length());
     }
 
     // manual construction - always verify usage
     TerminalNode(const opString& invalue, Token intoken, int line,
                  FileNode* infile) {
-        value = invalue;
+        Init();
+
         SetId(intoken);
         SetLine(line);
         SetFile(infile);
 
-        if (intoken == T_SPACER) value = "";
+        if (intoken != T_SPACER)
+            CopyText(invalue.GetCString(), invalue.Length());
     }
 
+    ~TerminalNode() { FreeValue(); }
+
     void PrintValue(opStringStream& s) {
         Token id = GetId();
 
@@ -92,7 +131,7 @@ class TerminalNode : public opNode {
 
     void PrintTransformed(opSectionStream& s) { PrintValue(s); }
 
-    void PrintString(opString& s) { s += value; }
+    void PrintString(opString& s) { s.GetString().append(GetText(), length); }
 
     static void MacroPrintEndl(opSectionStream& s, int& charnum) {
         const int desiredchar = 60;
@@ -113,9 +152,10 @@ class TerminalNode : public opNode {
         } else if (GetId() == T_WHITESPACE) {
             const int tabnum = 4;
 
-            int valuesize = value.Size();
+            const opString& whitespace = GetValue();
+            int valuesize = whitespace.Size();
             for (int i = 0; i < valuesize; i++) {
-                if (value[i] == '\t')
+                if (whitespace[i] == '\t')
                     charnum += tabnum;
                 else
                     charnum += 1;
@@ -123,21 +163,140 @@ class TerminalNode : public opNode {
 
             PrintValue(s);
         } else if (GetId() != T_COMMENT && GetId() != T_CCOMMENT) {
-            charnum += value.Length();
+            charnum += length;
             PrintValue(s);
         }
     }
 
-    const opString& GetValue() const { return value; }
+    // the value as a string: interned text, or for literals and comments
+    // a string the node owns
+    const opString& GetValue() const {
+        if (bOwnsValue) return *value;
+
+        if (symbol.IsNull()) Materialize();
+
+        return bOwnsValue ? *value : symbol.GetString();
+    }
+
+    // makes the value and views that instead of the file buffer (trees read
+    // by several threads must be materialized up front)
+    void Materialize() const {
+        if (bOwnsValue) return;
+
+        if (symbol.IsNull() && IsLiteral()) {
+            MakeValue();
+            return;
+        }
+
+        if (symbol.IsNull()) symbol = opSymbol::Intern(text, length);
+
+        text = symbol.GetString().GetCString();
+    }
+
+    // materializes every terminal in a tree
+    static void MaterializeTree(opNode* node) {
+        if (TerminalNode* terminal = node_cast<TerminalNode>(node))
+            terminal->Materialize();
+
+        opNode::iterator it = node->GetBegin();
+        opNode::iterator end = node->GetEnd();
 
-    opString ErrorName() { return value; }
+        while (it != end) {
+            MaterializeTree(*it);
+            ++it;
+        }
+    }
+
+    // prints without interning
+    void WriteValue(opStringStream& s) const { s.Write(GetText(), length); }
+
+    // the interned value (interned now if the scanner didn't)
+    opSymbol GetSymbol() const {
+        if (symbol.IsNull()) symbol = opSymbol::Intern(GetText(), length);
+
+        return symbol;
+    }
+
+    // compares the value with a symbol, without interning it
+    bool Is(const opSymbol& s) const {
+        if (!symbol.IsNull()) return symbol == s;
+
+        return s.Equals(GetText(), length);
+    }
+
+    opString ErrorName() { return GetValue(); }
     bool IsTerminal() { return true; }
     bool IsGrammar() { return false; }
 
     opString GetTreeValue() { return GetValue(); }
 
+    bool CacheMembers(opDialectCache& cache);
+
    protected:
-    opString value;
+    // copies text the tree doesn't own into its arena, or into a string
+    // the node owns if there's no arena
+    void CopyText(const char* source, int size) {
+        length = size;
+
+        if ((text = opNodeArena::CopyText(source, size))) return;
+
+        text = source;
+        MakeValue();
+    }
+
+    const char* GetText() const {
+        return bOwnsValue ? value->GetCString() : text;
+    }
+
+    // comments and literals are unbounded, so they aren't interned (the
+    // symbol table is never freed)
+    bool IsLiteral() const {
+        switch (GetId()) {
+            case T_COMMENT:
+            case T_CCOMMENT:
+            case T_HEXADECIMAL:
+            case T_NUMBER:
+            case T_DECIMAL:
+            case T_EXPONENTIAL:
+            case T_STRING:
+            case T_CHAR:
+            case T_WIDESTRING:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    // copies the text to a string the node owns, from the current arena
+    void MakeValue() const {
+        void* block = opNodeArena::Allocate(sizeof(opString));
+
+        value = new (block) opString(string(text, length));
+        bOwnsValue = true;
+    }
+
+    void FreeValue() {
+        if (!bOwnsValue) return;
+
+        value->~opString();
+        opNodeArena::Free((void*)value, sizeof(opString));
+        bOwnsValue = false;
+    }
+
+    // first, so they can go in the base's padding
+    int length : 31;
+    mutable unsigned int bOwnsValue : 1;
+
+    // a view into the file's source buffer, the tree's arena, a literal or
+    // interned text, or the node's own string
+    union {
+        mutable const char* text;
+        mutable const opString* value;
+    };
+
+    // set for identifiers the scanner interned (and their clones), and
+    // once the value has been asked for
+    mutable opSymbol symbol;
 };
 
 ///==========================================
@@ -1258,6 +1417,8 @@ class ScopeNode : public opNode {
 
     opString ErrorName();
 
+    bool CacheMembers(opDialectCache& cache);
+
    private:
     bool bGlobal;
     opDeque<opNode*> Scope;
@@ -1531,6 +1692,8 @@ class PreprocessorNode : public opNode {
 
     opString ErrorName();
 
+    bool CacheMembers(opDialectCache& cache);
+
    protected:
     opString DirectiveName;
 };
@@ -0,0 +1,70 @@
+///****************************************************************
+/// Copyright  2008 opGames LLC - All Rights Reserved
+///
+/// Authors: Kevin Depue & Lucas Ellis
+///
+/// File: Benchmark.h
+/// Date: 10/17/2026
+///
+/// Description:
+///
+/// Throughput counters for -benchmark.
+///****************************************************************
+
+namespace timing {
+
+///==========================================
+/// opBenchmark
+///==========================================
+
+// Counts the work done while compiling code files under -benchmark and
+// reports it as one line of json.  Dialect reading isn't counted, the
+// counters only run between Start and Report.
+class opBenchmark {
+   public:
+    enum Mode {
+        None,
+        Scan,   // stop each code file after scanning
+        Parse,  // scan and parse, but don't print
+        Emit,   // the full compile
+    };
+
+    // false if the mode isn't scan, parse or emit (or empty for none)
+    static bool SetMode(const opString& mode);
+
+    static Mode GetMode() { return CurrentMode; }
+
+    static void Start();
+    static void Report(int files);
+
+    /*=== counters ===*/
+
+    static void CountBytesRead(long long bytes) {
+        if (bCounting) BytesRead += bytes;
+    }
+
+    static void CountTokens(long long tokens) {
+        if (bCounting) Tokens += tokens;
+    }
+
+    static void CountNode() {
+        if (bCounting) ++Nodes;
+    }
+
+    static void CountBytesEmitted(long long bytes) {
+        if (bCounting) BytesEmitted += bytes;
+    }
+
+   private:
+    static Mode CurrentMode;
+    static opString ModeName;
+    static bool bCounting;
+    static double StartTime;
+
+    static std::atomic<long long> BytesRead;
+    static std::atomic<long long> Tokens;
+    static std::atomic<long long> Nodes;
+    static std::atomic<long long> BytesEmitted;
+};
+
+}  // namespace timing
@@ -30,3 +30,16 @@
 #ifdef PLATFORM_WINDOWS
 #define BOOST_FILESYSTEM_NO_LIB
 #endif
+
+// sse2 (the scanner skips runs of characters 16 at a time)
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SCANNER_SSE2
+#include <emmintrin.h>
+#ifdef PLATFORM_WINDOWS
+#include <intrin.h>
+#endif
+#endif
+
+// thread local storage (per-job compiler state, see -jobs)
+#define THREAD_LOCAL thread_local
@@ -41,6 +41,36 @@ class BasicTypes
     void FindBasicTypes();
 };
 
+// which tokens a node's children have, so a context can skip the passes
+// that can't find anything
+class TokenCensus {
+   public:
+    TokenCensus() { Count(NULL); }
+
+    // counts node's children (or nothing for NULL)
+    void Count(opNode* node) {
+        memset(Present, 0, sizeof(Present));
+
+        // Tokens_MIN stands for no token and is always there
+        Present[Tokens_MIN] = true;
+
+        if (!node) return;
+
+        opNode::iterator i = node->GetBegin();
+        opNode::iterator end = node->GetEnd();
+
+        for (; i != end; ++i) Present[i->GetId()] = true;
+    }
+
+    void Add(Token t) { Present[t] = true; }
+
+    bool Has(Token t) const { return Present[t]; }
+
+   private:
+    // node ids are 10 bits
+    bool Present[1 << 10];
+};
+
 template <class Parent>
 class Declaration
     : public CPPConstructs<CPlusPluses<Templated<Usings<Typedefs<TemplateDecls<
@@ -55,6 +85,26 @@ class Declaration
     virtual opString GetClassName();
     bool Parse();
     bool PostParse();
+
+   private:
+    // a pass of Parse - dispatched (-dispatchparse), it runs only if the
+    // children have both Needs tokens and then they may have the Makes
+    // tokens too (Tokens_MAX means anything, so they're counted again)
+    struct ParsePass {
+        void (Declaration::*Find)();
+        Token Needs[2];
+        Token Makes[2];
+    };
+
+    // the passes, in order
+    static const ParsePass ParsePasses[];
+
+    void RunParsePasses(bool bDispatch);
+
+    // passes Find can't point at directly
+    void FindConcatenations();
+    void FindClassDestructors() { this->FindDestructors(GetClassName()); }
+    void FindClassConstructors() { this->FindConstructors(GetClassName()); }
 };
 
 ///==========================================
@@ -70,67 +70,120 @@ inline bool Declaration<Parent>::Parse() {
 
     this->CleanAll();
 
-    // needs to be before arrays
-    this->FindOperators();  // operator ... [(...)]
+    RunParsePasses(opParameters::Get().DispatchParse);
 
-    this->FindAngles();
-
-    ConcatenationWalker performconcat(this);
-
-    this->FindCPlusPluses();
-
-    this->FindTemplateDecls();  // template< ... >
-
-    this->FindTemplateTypes();
-
-    this->FindSigned();
-    this->FindUnsigned();
-
-    this->FindModifiers();
-    this->FindValuedModifiers();
-
-    this->FindScopes();  // id::id
-
-    this->FindArrays();  // id[...][...]
-
-    this->FindPointers();
-
-    this->FindReferences();
-
-    this->FindFunctionPointers();
-
-    this->FindPointerMembers();
-
-    this->FindFunctions();
-
-    this->FindDestructors(GetClassName());
-
-    this->FindConstructors(GetClassName());
-
-    this->FindDestructorDefinitions();
-
-    this->FindConstructorDefinitions();
-
-    this->FindFunctionDefinitions();
+    PARSE_END;
+}
 
-    this->FindFriends();
+template <class Parent>
+const typename Declaration<Parent>::ParsePass
+    Declaration<Parent>::ParsePasses[] = {
+        {&Declaration::FindOperators, {T_OPERATOR}, {G_OPERATOR}},
+        {&Declaration::FindAngles, {T_LESS_THAN}, {G_ANGLED_BLOCK}},
+        {&Declaration::FindConcatenations,
+         {G_CONCATENATION_OPERATOR},
+         {Tokens_MAX}},
+        {&Declaration::FindCPlusPluses, {T_CPLUSPLUS}, {G_CPLUSPLUS}},
+        {&Declaration::FindTemplateDecls, {T_TEMPLATE}, {G_TEMPLATE_DECL}},
+        {&Declaration::FindTemplateTypes, {G_ANGLED_BLOCK}, {G_TEMPLATE_TYPE}},
+        {&Declaration::FindSigned, {T_SIGNED}, {G_FUNDAMENTAL_TYPE}},
+        {&Declaration::FindUnsigned, {T_UNSIGNED}, {G_FUNDAMENTAL_TYPE}},
+        {&Declaration::FindModifiers, {T_ID}, {T_MODIFIER}},
+        {&Declaration::FindValuedModifiers,
+         {T_ID, G_PAREN_BLOCK},
+         {G_VALUED_MODIFIER}},
+        {&Declaration::FindScopes,
+         {T_SCOPE_RESOLUTION},
+         {G_SCOPE, G_SCOPE_POINTER}},
+        {&Declaration::FindArrays, {G_BRACKET_BLOCK}, {G_ARRAY, G_TYPE_ARRAY}},
+        {&Declaration::FindPointers, {T_STAR}, {G_POINTER}},
+        {&Declaration::FindReferences, {T_AMPERSAND}, {G_REFERENCE}},
+        {&Declaration::FindFunctionPointers,
+         {G_PAREN_BLOCK},
+         {G_FUNCTION_POINTER}},
+        {&Declaration::FindPointerMembers,
+         {G_SCOPE_POINTER},
+         {G_POINTER_MEMBER}},
+        {&Declaration::FindFunctions, {G_PAREN_BLOCK}, {G_FUNCTION}},
+        {&Declaration::FindClassDestructors,
+         {G_FUNCTION, T_BITWISE_COMPLEMENT},
+         {G_DESTRUCTOR}},
+        {&Declaration::FindClassConstructors, {G_FUNCTION}, {G_CONSTRUCTOR}},
+        {&Declaration::FindDestructorDefinitions,
+         {G_DESTRUCTOR},
+         {G_DESTRUCTOR_DEFINITION, G_DESTRUCTOR_PROTOTYPE}},
+        {&Declaration::FindConstructorDefinitions,
+         {G_CONSTRUCTOR},
+         {G_CONSTRUCTOR_DEFINITION, G_CONSTRUCTOR_PROTOTYPE}},
+        {&Declaration::FindFunctionDefinitions,
+         {G_FUNCTION},
+         {G_FUNCTION_DEFINITION, G_FUNCTION_PROTOTYPE}},
+        {&Declaration::FindFriends, {T_FRIEND}, {G_FRIEND}},
+        {&Declaration::FindUsings, {T_USING}, {G_USING}},
+        {&Declaration::FindTypedefs, {T_TYPEDEF}, {G_TYPEDEF}},
+        {&Declaration::template FindVisibilityLabel<T_PUBLIC>,
+         {T_PUBLIC},
+         {G_VISIBILITY_LABEL}},
+        {&Declaration::template FindVisibilityLabel<T_PRIVATE>,
+         {T_PRIVATE},
+         {G_VISIBILITY_LABEL}},
+        {&Declaration::template FindVisibilityLabel<T_PROTECTED>,
+         {T_PROTECTED},
+         {G_VISIBILITY_LABEL}},
+        {&Declaration::template FindCPPConstructs<EnumNode, G_ENUM, T_ENUM>,
+         {T_ENUM},
+         {G_ENUM}},
+        {&Declaration::template FindCPPConstructs<UnionNode, G_UNION, T_UNION>,
+         {T_UNION},
+         {G_UNION}},
+        {&Declaration::template FindCPPConstructObjects<ClassNode, G_CLASS,
+                                                        T_CLASS>,
+         {T_CLASS},
+         {G_CLASS}},
+        {&Declaration::template FindCPPConstructObjects<StructNode, G_STRUCT,
+                                                        T_STRUCT>,
+         {T_STRUCT},
+         {G_STRUCT}},
+        {&Declaration::FindOPEnums, {T_OPENUM}, {G_OPENUM}},
+        {&Declaration::FindOPObjects, {T_OPOBJECT}, {G_OPOBJECT}},
+        {&Declaration::FindTemplated, {G_TEMPLATE_DECL}, {G_TEMPLATED}},
+        {NULL}};
+
+// runs the passes in order, then finds the statements - dispatched, a pass
+// only runs when the children have the tokens it looks for (one count of
+// the children decides most of them instead of a full scan per pass)
+template <class Parent>
+inline void Declaration<Parent>::RunParsePasses(bool bDispatch) {
+    TokenCensus census;
 
-    this->FindUsings();
+    if (bDispatch) census.Count(this);
 
-    this->FindTypedefs();
+    for (const ParsePass* pass = ParsePasses; pass->Find; ++pass) {
+        if (bDispatch &&
+            (!census.Has(pass->Needs[0]) || !census.Has(pass->Needs[1])))
+            continue;
 
-    this->FindVisibilityLabels();
+        (this->*pass->Find)();
 
-    this->FindCPPConstructs();
+        if (!bDispatch) continue;
 
-    this->FindOPEnums();
-    this->FindOPObjects();
+        if (pass->Makes[0] == Tokens_MAX)
+            census.Count(this);
+        else {
+            census.Add(pass->Makes[0]);
+            census.Add(pass->Makes[1]);
+        }
+    }
 
-    this->FindTemplated();
+    // a skipped pass leaves the position where the last one did
+    this->ResetPosition();
 
     this->FindBasicStatements();
+}
 
-    PARSE_END;
+template <class Parent>
+inline void Declaration<Parent>::FindConcatenations() {
+    ConcatenationWalker performconcat(this);
 }
 
 template <class Parent>
@@ -0,0 +1,167 @@
+///****************************************************************
+/// Copyright  2008 opGames LLC - All Rights Reserved
+///
+/// Authors: Kevin Depue & Lucas Ellis
+///
+/// File: DialectCache.h
+/// Date: 10/17/2026
+///
+/// Description:
+///
+/// Cache of registered dialect trees.
+///****************************************************************
+
+///==========================================
+/// opDialectCache
+///==========================================
+
+// Keeps a dialect's parsed tree next to its generated files (as
+// <output>.dohcache), so an unchanged dialect is read back instead of
+// being scanned and parsed again.  Registration then runs on the loaded
+// tree the way it does on a parsed one.  A cache is only used while the
+// manifest says the dialect is current and it's keyed by the recorded
+// inputs and the compiler build, an edited dialect (or opincluded file)
+// is reparsed and cached again.
+//
+// The tree is stored in preorder, a record per node:
+//
+//   id, line + 1, file, child count, members (see opNode::CacheMembers)
+//
+// where file is 0 for the parent's file, 1 for none, or the file node's
+// index + 2.  Members refer to other nodes by index + 1 (0 for NULL).  A
+// tree with a node that can't be cached isn't saved.
+class opDialectCache {
+   public:
+    // the cached tree, NULL if there's no cache or it's stale
+    static FileNode* Load(const opString& filename, const opString& key);
+
+    // caches a tree, false (and the cache is removed) if it can't be cached
+    static bool Save(FileNode* root, const opString& filename,
+                     const opString& key);
+
+    /*=== members ===*/
+
+    // true when loading (members are assigned), false when saving
+    bool IsReading() const { return bReading; }
+
+    // a node of the tree
+    template <class T>
+    void Node(T*& node) {
+        if (!bReading) {
+            Number(GetIndex(node));
+            return;
+        }
+
+        size_t index = GetNumber();
+
+        node = NULL;
+
+        // nodes later in the tree don't exist yet, assigned once they do
+        if (index) {
+            Fixup fixup = {(void*)&node, &AssignNode<T>, index - 1};
+            Fixups.push_back(fixup);
+        }
+    }
+
+    // a container of nodes
+    template <class container>
+    void Nodes(container& nodes) {
+        if (!Count(nodes)) return;
+
+        for (size_t i = 0; i < nodes.size(); i++) Node(nodes[i]);
+    }
+
+    // a container of enum values
+    template <class container>
+    void Values(container& values) {
+        if (!Count(values)) return;
+
+        for (size_t i = 0; i < values.size(); i++) {
+            if (bReading)
+                values[i] = (typename container::value_type)GetNumber();
+            else
+                Number((size_t)values[i]);
+        }
+    }
+
+    void Bool(bool& b);
+    void String(opString& s);
+    void Strings(opSet<opString>& strings);
+
+    // terminal text, loaded text views the cache's buffer
+    void Text(const char*& text, int& length);
+
+    // the member can't be cached
+    void Fail() { bFailed = true; }
+
+   private:
+    opDialectCache(bool breading)
+        : bReading(breading), bFailed(false), Data(NULL), Size(0), Pos(0) {}
+
+    // a node member assigned after loading
+    struct Fixup {
+        void* Member;
+        void (*Assign)(void* member, opNode* node);
+        size_t Index;
+    };
+
+    template <class T>
+    static void AssignNode(void* member, opNode* node) {
+        *(T**)member = static_cast<T*>(node);
+    }
+
+    bool WriteTree(FileNode* root, const opString& key);
+    FileNode* ReadTree(const opString& key);
+
+    // reads a node's record and creates it under parent (NULL for the
+    // root), NULL if it's invalid
+    opNode* ReadNode(opNode* parent, size_t& children);
+
+    void AddNodes(opNode* node);
+    size_t GetIndex(opNode* node);
+
+    // a container's size, resized when reading, false if it's invalid
+    template <class container>
+    bool Count(container& c) {
+        if (!bReading) {
+            Number(c.size());
+            return true;
+        }
+
+        size_t count = GetNumber();
+
+        // an element takes a byte at least
+        if (count > Size - Pos) {
+            Fail();
+            return false;
+        }
+
+        c.resize(count);
+        return true;
+    }
+
+    // variable length numbers
+    void Number(size_t n);
+    size_t GetNumber();
+
+    static opString GetStamp();
+
+    /*=== data ===*/
+
+    bool bReading;
+    bool bFailed;
+
+    // output when saving
+    string Out;
+
+    // input when loading
+    const char* Data;
+    size_t Size;
+    size_t Pos;
+
+    // the tree in preorder, and when saving sorted by node for lookups
+    opArray<opNode*> Tree;
+    vector<pair<opNode*, size_t> > Indices;
+
+    vector<Fixup> Fixups;
+};
@@ -53,6 +53,8 @@ class DialectModifierNode : public opNode {
 
     opString ErrorName() { return ModifierName; }
 
+    bool CacheMembers(opDialectCache& cache);
+
    protected:
     opString ModifierName;
 };
@@ -88,6 +90,8 @@ class ValuedDialectModiferNode : public DialectModifierNode {
         return name;
     }
 
+    bool CacheMembers(opDialectCache& cache);
+
    protected:
     ParenBlockNode* Value;
 };
@@ -180,6 +184,8 @@ class OrderModifierNodeBase : public ValuedDialectModiferNode {
 
     TerminalNode* GetLocation() { return Location; }
 
+    bool CacheMembers(opDialectCache& cache);
+
    private:
     TerminalNode* Location;
 };
@@ -247,6 +253,8 @@ class PrefixNodeBase : public ValuedDialectModiferNode {
 
     TerminalNode* GetPrefix() { return Prefix; }
 
+    bool CacheMembers(opDialectCache& cache);
+
    private:
     TerminalNode* Prefix;
 };
@@ -105,6 +105,8 @@ class CategoryNode : public DialectNodeBase {
         s += " { ... }";
     }
 
+    bool CacheMembers(opDialectCache& cache);
+
    private:
     TerminalNode* Name;
     CategoryBodyNode* Body;
@@ -146,6 +148,8 @@ class LocationNodeBase : public DialectNodeBase {
     opString ErrorName();
     void PrintXml(opXmlStream& stream);
 
+    bool CacheMembers(opDialectCache& cache);
+
    protected:
     opNode* Name;
 };
@@ -170,6 +174,8 @@ class CategoryLocationNode : public LocationNodeBase {
         s += " { ... }";
     }
 
+    bool CacheMembers(opDialectCache& cache);
+
    private:
     CategoryLocationBodyNode* Body;
 };
@@ -211,6 +217,8 @@ class MapNodeBase : public DialectNodeBase {
 
     OrderModifierNodeBase* GetOrder() { return Order; }
 
+    bool CacheMembers(opDialectCache& cache);
+
    protected:
     TerminalNode* Name;
     OrderModifierNodeBase* Order;
@@ -236,6 +244,8 @@ class CategoryMapNode : public MapNodeBase {
     void PrintDialectNode(opDialectStream& stream);
     void Register(DialectLocation* locationinfo);
 
+    bool CacheMembers(opDialectCache& cache);
+
    protected:
     CategoryMapBodyNode* Body;
     DialectMap* MapInfo;
@@ -297,6 +307,8 @@ class CategoryExpressionMapNode : public CategoryExpressionMapNodeParent {
 
     void PrintXml(opXmlStream& stream);
 
+    bool CacheMembers(opDialectCache& cache);
+
    private:
     DialectExpressionMap* ExpressionMap;
 };
@@ -361,6 +373,8 @@ class DisallowNode : public DialectNodeBase {
         if (Body) s += " { ... }";
     }
 
+    bool CacheMembers(opDialectCache& cache);
+
    private:
     TerminalNode* Name;
     DisallowBodyNode* Body;
@@ -388,6 +402,8 @@ class ModifierArgumentNode : public opNode {
 
     opString ErrorName();
 
+    bool CacheMembers(opDialectCache& cache);
+
    private:
     TerminalNode* Condition;
 };
@@ -421,6 +437,8 @@ class ModifierNodeBase : public DialectNodeBase {
     // fill in a description, if available
     bool GetDescription(opString& description);
 
+    bool CacheMembers(opDialectCache& cache);
+
    protected:
     TerminalNode* Name;
     ModifierArgumentNode* Arguments;
@@ -496,6 +514,8 @@ class CriteriaArgumentNode : public opNode {
 
     void PrintString(opString& s);
 
+    bool CacheMembers(opDialectCache& cache);
+
    private:
     TerminalNode* Argument;
 };
@@ -527,6 +547,8 @@ class IsNode : public CriteriaNodeBase {
 
     virtual bool Validate(DialectExpressionMap* map);
 
+    bool CacheMembers(opDialectCache& cache);
+
    private:
     IsBodyNode* Body;
 };
@@ -560,6 +582,8 @@ class CriteriaValueModifierNode : public CriteriaOperandNode {
 
     opString ErrorName();
 
+    bool CacheMembers(opDialectCache& cache);
+
    private:
     TerminalNode* Name;
     CriteriaArgumentNode* Argument;
@@ -600,6 +624,8 @@ class CriteriaBodyNode : public CriteriaBodyNodeParent {
     bool Validate(DialectExpressionMap* map);
     bool ValidateOperand(opNode* operand, DialectExpressionMap* map);
 
+    bool CacheMembers(opDialectCache& cache);
+
    protected:
     opArray<opNode*> Operands;
     opArray<Operator> Operators;
@@ -689,6 +715,8 @@ class NoteNode : public DialectNodeBase {
 
     void PrintString(opString& s);
 
+    bool CacheMembers(opDialectCache& cache);
+
    private:
     TerminalNode* Name;
     NoteBodyNode* Body;
@@ -714,6 +742,8 @@ class NoteArgumentNode : public opNode {
 
     opString ErrorName() { return ""; }
 
+    bool CacheMembers(opDialectCache& cache);
+
    private:
     TerminalNode* Name;
 };
@@ -731,6 +761,8 @@ class NoteArgumentListNode : public NoteArgumentListNodeParent {
 
     opString ErrorName();
 
+    bool CacheMembers(opDialectCache& cache);
+
    private:
     vector<NoteArgumentNode*> Arguments;
 };
@@ -797,6 +829,8 @@ class NoteDefinitionNode : public DialectNodeBase {
 
     bool PostParse();
 
+    bool CacheMembers(opDialectCache& cache);
+
    private:
     ScopeNode* Path;
     NoteArgumentListNode* Arguments;
@@ -846,6 +880,8 @@ class EnumerationNode : public DialectNodeBase {
         s += " { ... }";
     }
 
+    bool CacheMembers(opDialectCache& cache);
+
    private:
     TerminalNode* Name;
     EnumerationBodyNode* Body;
@@ -887,6 +923,8 @@ class EnumerationLocationNode : public LocationNodeBase {
 
     opString ErrorName();
 
+    bool CacheMembers(opDialectCache& cache);
+
    private:
     EnumerationLocationBodyNode* Body;
 };
@@ -983,6 +1021,8 @@ class CodeNode : public DialectNodeBase {
 
     bool GetVerbatim() { return bVerbatim; }
 
+    bool CacheMembers(opDialectCache& cache);
+
    private:
     TerminalNode* Name;
     CodeBodyNode* Body;
@@ -1026,6 +1066,8 @@ class ExtendPointNode : public DialectNodeBase {
         s += " { ... }";
     }
 
+    bool CacheMembers(opDialectCache& cache);
+
    private:
     TerminalNode* Name;
     BraceBlockNode* Body;
@@ -1064,6 +1106,8 @@ class ExtensionNode : public DialectNodeBase {
         Name->PrintString(s);
     }
 
+    bool CacheMembers(opDialectCache& cache);
+
    private:
     TerminalNode* Name;
     opArray<ExtendPointNode*> ExtendPoints;
@@ -1095,6 +1139,8 @@ class ExtensionPointNode : public DialectNodeBase {
 
     void PrintOriginal(opSectionStream& stream);
 
+    bool CacheMembers(opDialectCache& cache);
+
    private:
     TerminalNode* Name;
 };
@@ -1128,6 +1174,8 @@ class FileDeclarationLocationNode : public DialectNodeBase {
         Name->PrintString(s);
     }
 
+    bool CacheMembers(opDialectCache& cache);
+
    private:
     TerminalNode* Name;
     OrderModifierNodeBase* Order;
@@ -1174,6 +1222,8 @@ class FileDeclarationNode : public DialectNodeBase {
         s += " { ... }";
     }
 
+    bool CacheMembers(opDialectCache& cache);
+
    private:
     TerminalNode* Name;
     FileDeclarationBodyNode* Body;
@@ -1213,6 +1263,8 @@ class DialectNamespaceNode : public DialectNodeBase {
         s += " { ... }";
     }
 
+    bool CacheMembers(opDialectCache& cache);
+
    private:
     TerminalNode* Name;
     BraceBlockNode* Body;
@@ -48,6 +48,8 @@ class DialectStatementBase : public opNode {
 
     opString ErrorName();
 
+    bool CacheMembers(opDialectCache& cache);
+
    protected:
     /*=== data ===*/
 
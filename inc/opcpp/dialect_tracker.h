@@ -821,13 +821,15 @@ class DialectTracker {
     /**** static queries ****/
 
     static DialectCategory* GetCategory(const opString& name);
+    static DialectCategory* GetCategory(const opSymbol& name);
     static DialectEnumeration* GetEnumeration(const opString& name);
+    static DialectEnumeration* GetEnumeration(const opSymbol& name);
     static DialectTypeBase* GetType(const opString& name);
     static ExtensionNode* GetExtension(const opString& name);
     static DialectFileDeclaration* GetFileDeclaration(const opString& name);
-    static CategoryNode* GetAltClassPrefix(const opString& prefix);
-    static CategoryNode* GetAltStructPrefix(const opString& prefix);
-    static EnumerationNode* GetAltEnumerationPrefix(const opString& prefix);
+    static CategoryNode* GetAltClassPrefix(const opSymbol& prefix);
+    static CategoryNode* GetAltStructPrefix(const opSymbol& prefix);
+    static EnumerationNode* GetAltEnumerationPrefix(const opSymbol& prefix);
     static const opSet<opString>& GetAllPrefixes();
 
     /*=== get entire data structures ===*/
@@ -848,13 +850,31 @@ class DialectTracker {
 
     static bool Validate();
 
+    /**** dependency tracking ****/
+
+    // records the entities queried on this thread (NULL to stop), as
+    // "category:name", "enumeration:name", "extension:name", "extensions"
+    // (the set of extensions) and "names" (all type names and prefixes)
+    static void SetConsumer(opSet<opString>* entities) { Consumer = entities; }
+
+    // a recorded entity's fingerprint, changes when its definition does
+    static opString GetFingerprint(const opString& entity);
+
+    // the dialect files defining a recorded entity
+    static void GetEntityFiles(const opString& entity, opSet<opString>& files);
+
+    /**** reset ****/
+
+    // forget all registered dialects (the nodes are not deleted)
+    static void Reset();
+
    private:
     /**** typedefs ****/
 
-    typedef opHashTable<opString, DialectCategory*>::iterator categoryiterator;
-    typedef opHashTable<opString, DialectEnumeration*>::iterator
+    typedef opHashTable<opSymbol, DialectCategory*>::iterator categoryiterator;
+    typedef opHashTable<opSymbol, DialectEnumeration*>::iterator
         enumerationiterator;
-    typedef opHashTable<opString, opNode*>::iterator globaliterator;
+    typedef opHashTable<opSymbol, opNode*>::iterator globaliterator;
 
     /**** internal functions ****/
     void RegisterExtension(ExtensionNode* node);
@@ -866,6 +886,16 @@ class DialectTracker {
     DialectEnumeration* RegisterEnumeration(EnumerationNode* node);
     void RegisterNote(NoteDefinitionNode* notenode);
     bool ValidateNotes();
+    void Clear();
+
+    typedef opBuildManifest::hashtype hashtype;
+
+    static void Consume(const opString& entity) {
+        if (Consumer) Consumer->Insert(entity);
+    }
+
+    void AddFingerprint(const opString& entity, opNode* node);
+    static hashtype HashNode(opNode* node, hashtype hash);
 
     // RegisterGlobal
     // register a global name (to check for collisions of different types)
@@ -875,12 +905,12 @@ class DialectTracker {
 
     /**** registration data ****/
 
-    // category registration
-    opHashTable<opString, DialectCategory*> CategoryNodes;
-    opHashTable<opString, DialectEnumeration*> EnumerationNodes;
+    // category registration (keyed by interned name)
+    opHashTable<opSymbol, DialectCategory*> CategoryNodes;
+    opHashTable<opSymbol, DialectEnumeration*> EnumerationNodes;
 
     // global registration
-    opHashTable<opString, opNode*> GlobalNodes;
+    opHashTable<opSymbol, opNode*> GlobalNodes;
 
     // extension nodes
     opMap<opString, ExtensionNode*> ExtensionNodes;
@@ -890,11 +920,16 @@ class DialectTracker {
     opMap<opString, DialectFileDeclaration*> FileDeclarationNodes;
 
     // alt mappings
-    opMap<opString, CategoryNode*> AltClassMap;
-    opMap<opString, CategoryNode*> AltStructMap;
-    opMap<opString, EnumerationNode*> AltEnumMap;
+    opHashTable<opSymbol, CategoryNode*> AltClassMap;
+    opHashTable<opSymbol, CategoryNode*> AltStructMap;
+    opHashTable<opSymbol, EnumerationNode*> AltEnumMap;
     opSet<opString> Prefixes;
 
+    // entity fingerprints (and the files defining them)
+    opMap<opString, hashtype> Fingerprints;
+    opMap<opString, opSet<opString> > EntityFiles;
+    static THREAD_LOCAL opSet<opString>* Consumer;
+
     /**** creation, instance ****/
 
     DialectTracker();
@@ -905,6 +940,19 @@ class DialectTracker {
     static DialectTracker Instance;
 };
 
+//
+// DialectConsumer
+//
+
+// records the dialect entities queried while it's in scope
+struct DialectConsumer {
+    DialectConsumer(opSet<opString>& entities) {
+        DialectTracker::SetConsumer(&entities);
+    }
+
+    ~DialectConsumer() { DialectTracker::SetConsumer(NULL); }
+};
+
 //
 // Dialect Paths
 //
@@ -11,10 +11,65 @@
 /// opDriver class declaration.
 ///****************************************************************
 
+//
+// opCompileJob
+//
+
+// a code file compiled by a worker thread (-jobs)
+struct opCompileJob {
+    opCompileJob() : bDone(false), bResult(false), NumErrors(0) {}
+
+    path File;
+
+    // buffered log output, replayed in file order
+    opArray<opString> Output;
+
+    bool bDone;
+    bool bResult;
+    int NumErrors;
+
+    // rethrown on the main thread
+    std::exception_ptr Exception;
+};
+
+//
+// opJobQueue
+//
+
+// hands out compile jobs to worker threads in file order
+class opJobQueue {
+   public:
+    explicit opJobQueue(const opSet<path>& files);
+
+    // returns the next job index, -1 when there are none left
+    int Next();
+
+    // marks a job as finished
+    void Finish(int index);
+
+    // blocks until a job is finished
+    opCompileJob& Wait(int index);
+
+    // stops handing out jobs
+    void Cancel();
+
+    opCompileJob& GetJob(int index) { return Jobs[index]; }
+
+    int Size() const { return Jobs.Size(); }
+
+   private:
+    opArray<opCompileJob> Jobs;
+    int NextJob;
+
+    boost::mutex Mutex;
+    boost::condition_variable Finished;
+};
+
 class opDriver {
    public:
     // construction / destruction
-    opDriver() {}
+    opDriver()
+        : bResidentDialects(false), bResidentValidated(false), ResidentTime(0) {}
     virtual ~opDriver() {}
 
     // utility
@@ -23,6 +78,10 @@ class opDriver {
     // only to be called once
     void Initialize();
 
+    // keep dialects loaded between Convert calls (compile server),
+    // they're reread when a .doh or one of its includes changes
+    void SetResidentDialects(bool bresident);
+
     // find all files of extension 'ext' in a directory
     static void FindFilesInDirectory(const opString& directory,
                                      const string& ext,
@@ -34,6 +93,9 @@ class opDriver {
     // get all doh files listed in parameters
     static opSet<path> GetDialectFiles() { return DohFiles; }
 
+    // every dialect file read, the listed ones and what they opinclude
+    static const opSet<opString>& GetDialectInputs() { return DialectInputs; }
+
     // returns true if the file exists in the files specified on
     // the command line arguments
     static bool FileExists(path file);
@@ -48,11 +110,11 @@ class opDriver {
     // validate all dialect files listed in parameters
     static bool ValidateDialectFiles(const opParameters& p);
 
-    // get the latest timestamp of all dialects used
-    static time_t GetDialectTimestamp(const opParameters& p);
+    // options recorded in the build manifest
+    static opString GetManifestOptions(const opParameters& p);
 
-    // get the latest timestamp of all generated dialects used
-    static time_t GetGeneratedDialectTimestamp(const opParameters& p);
+    // hash of the dialect inputs recorded in the build manifest
+    static opString GetDialectState(const opParameters& p);
 
     // is an additional dependency out of date?
     // if so update it and return true
@@ -67,9 +129,21 @@ class opDriver {
     // operate on a single file
     bool NormalModeFile(const opParameters& p, const path& filename);
 
+    // compile files on several worker threads
+    bool NormalModeJobs(const opParameters& p, const opSet<path>& files,
+                        int numjobs);
+
+    // worker thread loop
+    void NormalModeWorker(const opParameters* p, opJobQueue* queue);
+
     // dialect reading mode
     bool DialectMode(const opParameters& p);
 
+    // resident dialect support
+    opString GetResidentKey(const opParameters& p);
+    bool ResidentDialectsCurrent(const opParameters& p);
+    void ReleaseResidentDialects();
+
     // operate on a single file
     bool DialectModeFile(const opParameters& p, const path& filename);
 
@@ -77,7 +151,7 @@ class opDriver {
     bool GlobMode(const opParameters& p);
 
    public:
-    // timestamp checking
+    // up to date checking (build manifest)
 
     // are all dialects up to date?
     bool DialectsCurrent();
@@ -105,5 +179,14 @@ class opDriver {
 
     static opSet<path> OhFiles;
     static opSet<path> DohFiles;
-    static int NumErrors;
+    static opSet<opString> DialectInputs;
+    static opString DialectState;
+    static THREAD_LOCAL int NumErrors;
+
+    // resident dialects
+    bool bResidentDialects;
+    bool bResidentValidated;
+    opString ResidentKey;
+    time_t ResidentTime;
+    opMap<opString, DialectFileNode*> ResidentFiles;
 };
@@ -217,10 +217,11 @@ class opError {
 
     /*=== data ===*/
 
-    static opList<ErrorInfo> Errors;
+    // per-thread, each compile job collects its own errors
+    static THREAD_LOCAL opList<ErrorInfo> Errors;
     static opString ParseErrors[Tokens_MAX + 1];
-    static Token ContextToken;
-    static opNode* ContextNode;
+    static THREAD_LOCAL Token ContextToken;
+    static THREAD_LOCAL opNode* ContextNode;
     static int MaxErrorNameLength;
 };
 
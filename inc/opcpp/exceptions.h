@@ -113,10 +113,10 @@ class opException {
     };
 
    private:
-    static int ExceptionCount;
+    static THREAD_LOCAL int ExceptionCount;
 
     // exception override
-    static ExceptionType ExceptionOverride;
+    static THREAD_LOCAL ExceptionType ExceptionOverride;
 
     // handles override dispatching
     template <class defaulttype>
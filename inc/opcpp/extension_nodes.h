@@ -611,6 +611,8 @@ class OPDefineNode : public DialectNodeBase {
         s += " { ... }";
     }
 
+    bool CacheMembers(opDialectCache& cache);
+
    private:
     TerminalNode* Name;
     ParenBlockNode* Arguments;
@@ -674,6 +676,8 @@ class OPIncludeNode : public DialectNodeBase {
         FileName->PrintString(s);
     }
 
+    bool CacheMembers(opDialectCache& cache);
+
    private:
     // register dependencies
     void RegisterDependency(const opString& filename);
@@ -703,6 +707,8 @@ class OPMacroArgumentNode : public opNode {
 
     void PrintString(opString& s) { VariableName->PrintString(s); }
 
+    bool CacheMembers(opDialectCache& cache);
+
    private:
     opNode* VariableName;
 };
@@ -734,6 +740,8 @@ class OPMacroArgumentListNode : public OPMacroArgumentListNodeParent {
         s += ")";
     }
 
+    bool CacheMembers(opDialectCache& cache);
+
    private:
     vector<OPMacroArgumentNode*> Arguments;
 };
@@ -783,6 +791,7 @@ class OPMacroNode : public DialectNodeBase {
     void PrintTransformed(opSectionStream& stream) {}
 
     opString GetSignature();
+    opMacroSignature GetKey();
 
     bool PreProcess();
 
@@ -807,6 +816,8 @@ class OPMacroNode : public DialectNodeBase {
    public:
     void Expand(opNode* cloned, ExpandCallArgumentListNode* args);
 
+    bool CacheMembers(opDialectCache& cache);
+
    private:
     TerminalNode* Name;
     OPMacroArgumentListNode* Arguments;
@@ -14,10 +14,53 @@
 #pragma once
 
 #include <stdio.h>
+#include <string.h>
 
 #define BOOST_FILESYSTEM_NO_LIB
 #include <boost/filesystem/operations.hpp>
 
+#ifndef PLATFORM_WINDOWS
+#include <sys/mman.h>
+#endif
+
+// a whole file's text, memory mapped or read into memory, a mapping is
+// private so the text can still be changed in place (see opScanner)
+class FileBuffer {
+   public:
+    FileBuffer() : data(NULL), size(0), bMapped(false) {}
+
+    ~FileBuffer() { Clear(); }
+
+    void Clear() {
+#ifndef PLATFORM_WINDOWS
+        if (bMapped) munmap(data, size);
+#endif
+
+        if (!bMapped) delete[] data;
+
+        data = NULL;
+        size = 0;
+        bMapped = false;
+    }
+
+    size_t Size() const { return size; }
+
+    char& operator[](size_t index) { return data[index]; }
+
+    const char& operator[](size_t index) const { return data[index]; }
+
+   private:
+    friend class FileReadStream;
+
+    // tokens share it instead (see opSourceBuffer)
+    FileBuffer(const FileBuffer&);
+    FileBuffer& operator=(const FileBuffer&);
+
+    char* data;
+    size_t size;
+    bool bMapped;
+};
+
 class FileReadStream {
    public:
     FileReadStream(const opString& filename) : name(filename) {
@@ -30,32 +73,79 @@ class FileReadStream {
 
     template <class type>
     void ReadToContainer(type& c) {
-        int size = (int)boost::filesystem::file_size(name.GetString());
+        size_t size = GetSize();
 
         c.Resize(size);
 
         if (size > 0) fread(&c[0], sizeof(char), size, file);
     }
 
+    // maps the file if it's large enough for that to beat a copy,
+    // otherwise (or if mapping fails) reads it
+    void ReadToBuffer(FileBuffer& buffer) {
+        buffer.Clear();
+
+        size_t size = GetSize();
+
+        if (size == 0) return;
+
+#ifndef PLATFORM_WINDOWS
+        if (size >= MapThreshold) {
+            void* data = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE,
+                              fileno(file), 0);
+
+            if (data != MAP_FAILED) {
+                buffer.data = (char*)data;
+                buffer.size = size;
+                buffer.bMapped = true;
+                return;
+            }
+        }
+#endif
+
+        buffer.data = new char[size];
+        buffer.size = fread(buffer.data, sizeof(char), size, file);
+    }
+
    private:
+    size_t GetSize() {
+        return (size_t)boost::filesystem::file_size(name.GetString());
+    }
+
+    // smaller files are read
+    static const size_t MapThreshold = 16 * 1024;
+
     opString name;
     FILE* file;
 };
 
+// buffers its output and only replaces the file when the contents
+// changed, so unchanged generated files keep their timestamps
 class FileWriteStream {
    public:
-    FileWriteStream(const opString& filename) : name(filename) {
-        file = fopen(filename.GetCString(), "wb");
+    FileWriteStream(const opString& filename)
+        : name(filename), bOpen(false), bChanged(false) {
+        // make sure we'll be able to write it
+        FILE* file = fopen(filename.GetCString(), "ab");
+
+        if (file) {
+            bOpen = true;
+            fclose(file);
+        }
     }
 
-    ~FileWriteStream() {
-        if (file) fclose(file);
-    }
+    ~FileWriteStream() { Close(); }
 
-    bool IsOpen() { return file != NULL; }
+    bool IsOpen() { return bOpen; }
 
     bool is_open() { return IsOpen(); }
 
+    // true if closing replaced the file
+    bool IsChanged() const { return bChanged; }
+
+    // bytes written so far
+    size_t Size() const { return buffer.size(); }
+
     template <class type>
     friend FileWriteStream& operator<<(FileWriteStream& stream,
                                        const type& data) {
@@ -64,11 +154,71 @@ class FileWriteStream {
         return stream;
     }
 
-    void Write(const opString& s) { fwrite(&s[0], 1, s.Length(), file); }
+    void Write(const opString& s) { buffer.append(s.GetCString(), s.Length()); }
+
+    void Write(const char& s) { buffer += s; }
+
+    // compares against the existing file, replaces it if different
+    void Close() {
+        if (!bOpen) return;
+
+        bOpen = false;
+
+        if (IsSame()) return;
+
+        // write a temporary and rename it over the file
+        string temp = name.GetString() + ".tmp";
+        FILE* file = fopen(temp.c_str(), "wb");
+
+        if (!file) return;
+
+        size_t written = fwrite(buffer.data(), 1, buffer.size(), file);
+
+        fclose(file);
+
+        if (written != buffer.size()) {
+            ::remove(temp.c_str());
+            return;
+        }
 
-    void Write(const char& s) { fwrite(&s, sizeof(char), 1, file); }
+        if (::rename(temp.c_str(), name.GetCString()) != 0) {
+            // windows won't rename over an existing file
+            ::remove(name.GetCString());
+            ::rename(temp.c_str(), name.GetCString());
+        }
+
+        bChanged = true;
+    }
 
    private:
+    bool IsSame() {
+        FILE* file = fopen(name.GetCString(), "rb");
+
+        if (!file) return false;
+
+        char chunk[16384];
+        size_t offset = 0;
+        bool bSame = true;
+
+        while (bSame) {
+            size_t count = fread(chunk, 1, sizeof(chunk), file);
+
+            if (count == 0) break;
+
+            if (count > buffer.size() - offset ||
+                memcmp(chunk, buffer.data() + offset, count) != 0)
+                bSame = false;
+
+            offset += count;
+        }
+
+        fclose(file);
+
+        return bSame && offset == buffer.size();
+    }
+
     opString name;
-    FILE* file;
+    string buffer;
+    bool bOpen;
+    bool bChanged;
 };
@@ -30,6 +30,8 @@ class FileNode : public FileNodeParent {
         SetLine(0);
         SetFile(this);
         bAbsolutePath = false;
+        bResident = false;
+        Arena = NULL;
     }
 
     ~FileNode();
@@ -44,6 +46,8 @@ class FileNode : public FileNodeParent {
 
     virtual FileNode* ToFileNode() { return this; }
 
+    bool CacheMembers(opDialectCache& cache);
+
     // load this file to this node, should we scan/identify test mode tokens?
     // should always return a file, but do check the errors
     template <class T>
@@ -70,6 +74,7 @@ class FileNode : public FileNodeParent {
     // utility
     virtual bool Preprocessor();
     bool CheckBlockCorrectness();
+    void FindBlocks();
 
     void PrintIncluded(opDialectStream& stream);
     void PrintIncluded(opFileStream& stream);
@@ -79,6 +84,9 @@ class FileNode : public FileNodeParent {
     opString WriteFileHeader(stringstream& o, opString filename);
 
    private:
+    template <class T>
+    void CollapseBlock(iterator left, iterator right);
+
     // input filename
     opString InputName;
 
@@ -108,12 +116,42 @@ class FileNode : public FileNodeParent {
 
     bool IsDependencyNewer(time_t timestamp);
 
+    const opSet<opString>& GetDependencies() const { return Dependencies; }
+
+    // dialect entities used by this file, saved with their fingerprints
+    // after a "[dialect]" line in the .depend file
+    void AddDialectDependencies(const opSet<opString>& entities);
+
+    // true if dialect entities were recorded and none have changed
+    bool IsDialectDependencyCurrent();
+
+    // writes a Makefile syntax depfile (-depfiles) making the generated
+    // files depend on source, its dependencies and the dialect files used
+    void SaveDepfile(const opString& filepath, const opString& oohpath,
+                     const opString& ocpppath, const opString& source);
+
+    // resident files survive DeleteLoadedFiles (compile server dialects)
+    void SetResident(bool bresident) { bResident = bresident; }
+
+    bool IsResident() { return bResident; }
+
+    // keeps the scanned text alive for terminals that view it
+    void SetSourceBuffer(const opSourceBuffer& buffer) {
+        SourceBuffer = buffer;
+    }
+
    private:
     opSet<opString> Dependencies;
+    opMap<opString, opString> DialectDependencies;
+    bool bResident;
+    opSourceBuffer SourceBuffer;
+
+    // the tree's arena (NULL for included files, they're in the includer's)
+    opNodeArena* Arena;
 
    private:
     // internal file tables
-    static opArray<FileNode*> FileTable;
+    static THREAD_LOCAL opArray<FileNode*> FileTable;
 
     static FileNode* GetLoadedFile(const opString& filename);
 
@@ -125,6 +163,7 @@ class FileNode : public FileNodeParent {
    private:
     friend class opDriver;
     friend class opMemoryTracker;
+    friend class ::opDialectCache;
 };
 
 ///==========================================
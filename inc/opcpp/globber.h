@@ -51,10 +51,26 @@ class Globber {
     // void UpdateSourceIndex(const vector<ohfileinfo>& files, const path&
     // indexpath, const opParameters& p );
 
-    // actually create and write the indexes
+    // actually create and write the indexes (true if replaced)
     template <bool bheader>
-    void WriteIndex(const vector<ohfileinfo>& files, const path& headerindex,
-                    const opParameters& p);
+    bool WriteIndex(const vector<ohfileinfo>& files, const path& headerindex,
+                    const opParameters& p, bool bdialects = true);
+
+    // write the source index as shards (-globshards)
+    void UpdateShards(const vector<ohfileinfo>& files, const path& outputpath,
+                      const opParameters& p);
+
+    // split files between shards by generated size, files keep the
+    // shard they had last time (recorded in Generated.globshards)
+    void AssignShards(const vector<ohfileinfo>& files,
+                      vector<vector<ohfileinfo> >& shards,
+                      const path& assignpath);
+
+   public:
+    // path of a source index shard
+    static path GetShardPath(const path& outputpath, int shard);
+
+   private:
 
     // write the file list to a stream...
     template <bool bheader>
@@ -22,7 +22,7 @@ inline opStringStream& operator<<(opStringStream& oin, TerminalNode* node) {
     }
 
     oin.NoteLineNumber(node->GetFile(), node->GetLine());
-    oin << node->GetValue();
+    node->WriteValue(oin);
 
     return oin;
 }
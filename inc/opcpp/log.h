@@ -36,6 +36,12 @@ class opLog {
     static void SetStream(ostream& s) { o = &s; }
 
     static void Log(const opString& s) {
+        // compile jobs buffer their output, it's replayed in order later
+        if (Capture) {
+            Capture->PushBack(s);
+            return;
+        }
+
         opString log = s;
 
         if (log.Trim() == "" && lastLog == "")
@@ -50,11 +56,15 @@ class opLog {
 
     static void DebugLog(const opString& s);
 
+    // buffer this thread's log lines instead of writing them (NULL to stop)
+    static void SetCapture(opArray<opString>* lines) { Capture = lines; }
+
    private:
     /*=== data ===*/
 
     static ostream* o;
     static opString lastLog;
+    static THREAD_LOCAL opArray<opString>* Capture;
 };
 
 // Method to log an error.
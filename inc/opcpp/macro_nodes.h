@@ -45,6 +45,8 @@ class ExpandCallArgumentListNode : public ExpandCallArgumentListNodeParent {
 
     opString ErrorName();
 
+    bool CacheMembers(opDialectCache& cache);
+
    private:
     vector<ExpandCallArgumentNode*> Arguments;
 };
@@ -75,6 +77,7 @@ class ExpandCallNode : public opNode {
 
     // get the opmacro signature we want to match
     opString GetSignature();
+    opMacroSignature GetKey();
 
     // protected:
     bool Expand(opSymbolTracker& tracker, opNode::iterator expandit,
@@ -82,10 +85,12 @@ class ExpandCallNode : public opNode {
 
     friend class opMacroExpander;
 
+    bool CacheMembers(opDialectCache& cache);
+
    private:
     opNode* Name;
     ExpandCallArgumentListNode* Arguments;
-    static int ExpansionDepth;
+    static THREAD_LOCAL int ExpansionDepth;
 };
 
 ///
@@ -99,10 +104,23 @@ class ExpandableNode : public opNode {
    public:
     DECLARE_NODE(ExpandableNode, opNode, T_UNKNOWN);
 
+    void Init() { bShares = false; }
+
+    ~ExpandableNode();
+
     /**** operations for expandable nodes ****/
     void ReplaceNodes(const opString& matchname, iterator start, iterator end);
     void ReplaceNodes(const opString& matchname, opNode* node);
 
+    // body's children with every terminal named by an argument replaced by
+    // its value - the same as cloning body and calling ReplaceNodes for each
+    // argument in turn, but only the blocks on the way to a replacement are
+    // copied.  The rest is shared with body, which has to outlive the
+    // expansion (and isn't changed by it).
+    static stacked<ExpandableNode> Expand(opNode* body,
+                                          const vector<opString>& names,
+                                          const vector<opNode*>& values);
+
     void CallExpands();
     void CallOperators();
 
@@ -114,11 +132,37 @@ class ExpandableNode : public opNode {
 
    private:
     /**** recursive functions ****/
-    void DoReplacement(opNode* currentnode, const opString& matchname,
+    void DoReplacement(opNode* currentnode, const opSymbol& matchname,
                        iterator start, iterator end);
-    void DoReplacement(opNode* currentnode, const opString& matchname,
+    void DoReplacement(opNode* currentnode, const opSymbol& matchname,
                        opNode* replacement);
 
+    void ExpandChildren(opNode* source, opNode* target,
+                        const vector<opSymbol>& names,
+                        const vector<opNode*>& values);
+
+    // appends node to target with the arguments from first on replaced
+    void AppendReplaced(opNode* node, opNode* target, int first,
+                        const vector<opSymbol>& names,
+                        const vector<opNode*>& values);
+
+    // a block like the given one, without its children
+    template <class T>
+    static stacked<opNode> CopyBlock(T* block) {
+        stacked<T> copy = NEWNODE(T);
+        block->CloneBasics(*copy);
+        return stacked<opNode>::buildstacked(*copy);
+    }
+
+    static int FindArgument(opNode* node, const vector<opSymbol>& names);
+    static bool ContainsArgument(opNode* node, const vector<opSymbol>& names);
+
+    // takes the shared nodes back out before the tree is deleted
+    static void Unshare(opNode* node);
+
+    // true if this is an expansion sharing nodes with its body
+    bool bShares;
+
     // TODO: add expand (find and call)
     //		add operator calls
 };
@@ -144,6 +188,8 @@ class ExpandableArgumentNode : public opNode {
 
     opString ErrorName() { return ""; }
 
+    bool CacheMembers(opDialectCache& cache);
+
    private:
     opString value;
 };
@@ -181,6 +227,8 @@ class ConcatenationArgumentOperatorNode : public opNode {
         CloneChildren(node);
     }
 
+    bool CacheMembers(opDialectCache& cache);
+
    private:
     opNode* Argument;
 };
@@ -220,6 +268,8 @@ class ConcatenationOperatorNode : public opNode {
     void PrintOriginal(opSectionStream& stream);
     void PrintString(opString& s);
 
+    bool CacheMembers(opDialectCache& cache);
+
    private:
     ConcatenationArgumentOperatorNode* Left;
     ConcatenationArgumentOperatorNode* Right;
@@ -79,7 +79,7 @@
 #define IMPLEMENTS_INTERFACE(iface)                     \
    public:                                              \
     typedef Parent Super;                               \
-    typedef opList<opNode*>::pointer_iterator iterator; \
+    typedef opNodeBase::iterator iterator;              \
     enum implements_##iface{iface##_implementation};    \
     iface<Parent>() { this->Init(); }
 
@@ -0,0 +1,102 @@
+///****************************************************************
+/// Copyright  2008 opGames LLC - All Rights Reserved
+///
+/// Authors: Kevin Depue & Lucas Ellis
+///
+/// File: Manifest.h
+/// Date: 10/17/2026
+///
+/// Description:
+///
+/// Content hash build manifest.
+///****************************************************************
+
+///==========================================
+/// opBuildManifest
+///==========================================
+
+// Records, per generated output, the content hash of every input it
+// was built from.  Up to date checks compare hashes instead of
+// timestamps, so touching or checking out a file doesn't recompile it.
+// Kept as text in the generated directory:
+//
+//   stamp <compiler build>
+//   options <hash of output affecting options>
+//   output <generated path>
+//   dialects <dialect state hash>   (code files only)
+//   input <hash> <path>
+//   globbed                         (generated list is complete)
+//   generated <generated path>
+class opBuildManifest {
+   public:
+    typedef unsigned long long hashtype;
+
+    enum Status { Changed, DialectsChanged, Current };
+
+    // opens a manifest (entries from another build or options are dropped)
+    static void Load(const opString& filename, const opString& options);
+
+    // writes the manifest if it changed and closes
+    static void Save();
+
+    // closes without writing
+    static void Close();
+
+    // content hash of a file as hex, "none" if it can't be read
+    // (cached until the manifest closes)
+    static opString HashFile(const opString& filename);
+
+    // hash of a string as hex
+    static opString HashString(const opString& s);
+
+    // 64-bit fnv-1a (pass a previous hash to continue it)
+    static hashtype Hash(const char* data, size_t size,
+                         hashtype hash = 14695981039346656037ULL) {
+        for (size_t i = 0; i < size; i++) {
+            hash ^= (unsigned char)data[i];
+            hash *= 1099511628211ULL;
+        }
+
+        return hash;
+    }
+
+    // compares an output's recorded inputs against their current contents
+    static Status Check(const opString& output,
+                        const opString& dialects = "");
+
+    // records an output's inputs as they are now
+    static void Record(const opString& output, const opSet<opString>& inputs,
+                       const opString& dialects = "");
+
+    // drops an output (it's being rebuilt)
+    static void Forget(const opString& output);
+
+    // the recorded inputs of an output and their hashes
+    static opString GetInputState(const opString& output);
+
+    // generated .ooh/.ocpp pairs (by path without extension), known
+    // once the globber has walked the generated directory
+    static bool GetGenerated(opSet<opString>& outputs);
+    static void SetGenerated(const opSet<opString>& outputs);
+    static void AddGenerated(const opString& output);
+
+   private:
+    struct Entry {
+        opString Dialects;
+        opMap<opString, opString> Inputs;
+    };
+
+    static opString GetStamp();
+
+    /*=== data ===*/
+
+    static opMap<opString, Entry> Entries;
+    static opMap<opString, opString> Hashes;
+    static opSet<opString> Generated;
+    static bool bGenerated;
+    static opString FileName;
+    static opString Options;
+    static bool bOpen;
+    static bool bDirty;
+    static boost::mutex Mutex;
+};
@@ -21,6 +21,89 @@ struct opHashFunction<opNode*> {
 
 namespace memory {
 
+//
+// Node Arenas
+//
+
+// Bump allocator for a loaded file's tree: its nodes, their child arrays and
+// cloned terminal text.  Allocations come from the current thread's arena,
+// or the heap if there isn't one (or they're big), behind a header naming
+// the arena, so deleting a node works either way.  Blocks freed on the
+// arena's own thread are reused for the same size, otherwise the memory is
+// only returned when the arena is deleted (after its tree - destructors
+// still run).
+class opNodeArena {
+   public:
+    opNodeArena();
+    ~opNodeArena();
+
+    /**** allocation ****/
+
+    static void* Allocate(size_t size);
+    static void Free(void* block, size_t size);
+
+    // copies text into the current arena, NULL if there isn't one
+    static const char* CopyText(const char* text, int length);
+
+    /**** current arena ****/
+
+    static opNodeArena* GetCurrent() { return Current; }
+
+    // makes an arena current for a scope (NULL for the heap)
+    class Scope {
+       public:
+        Scope(opNodeArena* arena) : Previous(Current) { Current = arena; }
+
+        ~Scope() { Current = Previous; }
+
+       private:
+        opNodeArena* Previous;
+    };
+
+    /**** queries ****/
+
+    bool Contains(const void* block) const;
+
+    size_t GetSize() const { return Size; }
+
+   private:
+    // every block starts with one, the arena is NULL for heap blocks
+    struct Header {
+        opNodeArena* Arena;
+    };
+
+    static const size_t ChunkSize = 64 * 1024;
+    static const size_t Alignment = sizeof(Header);
+    static const size_t MaxReused = 512;
+
+    static size_t Align(size_t size) {
+        return (size + Alignment - 1) & ~(Alignment - 1);
+    }
+
+    void* Bump(size_t size);
+
+    /*=== data ===*/
+
+    struct Chunk {
+        char* Data;
+        size_t Size;
+    };
+
+    opArray<Chunk> Chunks;
+    char* Next;
+    char* End;
+    size_t Size;
+
+    // freed blocks by aligned size (linked through their first word)
+    void* Reuse[MaxReused / Alignment + 1];
+
+    static THREAD_LOCAL opNodeArena* Current;
+
+    // not copyable
+    opNodeArena(const opNodeArena&);
+    opNodeArena& operator=(const opNodeArena&);
+};
+
 #ifdef _DEBUG
 
 class opMemoryTracker {
@@ -34,7 +117,12 @@ class opMemoryTracker {
     static void Register(opNode* newnode);
     static void UnRegister(opNode* newnode);
 
+    // reports the nodes still in an arena that's being deleted
+    static void ArenaDeleted(const opNodeArena* arena);
+
    private:
+    static void ReportLeak(opNode* node);
+
     static opMemoryTracker* instance;
 
     opSet<opNode*> TrackedNodes;
@@ -51,6 +139,7 @@ class opMemoryTracker {
 
     static void Register(opNode* newnode) {}
     static void UnRegister(opNode* newnode) {}
+    static void ArenaDeleted(const opNodeArena* arena) {}
 };
 
 #endif
@@ -141,6 +230,7 @@ class NewHandler {
         newnode->SetAllocationLocation(file + "(" + linenumber + ")");
 #endif
         newnode->PostInit();
+        opBenchmark::CountNode();
         return stacked<T>(newnode);
     }
 };
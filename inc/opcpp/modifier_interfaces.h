@@ -12,7 +12,7 @@ class ModifierSupport : public Parent, public ModifierSupportBase {
     void Init();
 
     // looks at auto and specified modifiers
-    virtual bool HasModifier(const opString& modifiername);
+    virtual bool HasModifier(const opSymbol& modifiername);
 
     // only looks at special modifiers
     virtual bool HasModifier(Token modifiertoken);
@@ -10,8 +10,10 @@ inline void ModifierSupport<Parent>::Init() {
 
 // looks at auto and specified modifiers
 template <class Parent>
-inline bool ModifierSupport<Parent>::HasModifier(const opString& modifiername) {
-    if (TerminalNode* node = FetchBasicModifier(modifiername)) {
+inline bool ModifierSupport<Parent>::HasModifier(const opSymbol& modifiername) {
+    const opString& name = modifiername.GetString();
+
+    if (TerminalNode* node = FetchBasicModifier(name)) {
         return true;
     }
 
@@ -19,7 +21,7 @@ inline bool ModifierSupport<Parent>::HasModifier(const opString& modifiername) {
         if (modifiers->HasModifier(modifiername)) return true;
     }
 
-    if (GetVisibility(modifiername)) return true;
+    if (GetVisibility(name)) return true;
 
     // TODO: should we maybe add these modifiers to this node?
 
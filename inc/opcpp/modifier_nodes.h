@@ -35,7 +35,7 @@ class ModifiersBase : public opNode {
 
     /**** queries ****/
 
-    bool HasModifier(const opString& modifiername);
+    bool HasModifier(const opSymbol& modifiername);
     bool HasModifier(Token modifiertoken);
     TerminalNode* FindModifier(Token modifiertoken);
     ValuedModifierNode* GetValuedModifier(const opString& modifiername);
@@ -54,6 +54,8 @@ class ModifiersBase : public opNode {
         }
     }
 
+    bool CacheMembers(opDialectCache& cache);
+
    private:
     vector<opNode*> Modifiers;
 };
@@ -110,7 +112,7 @@ class ModifierSupportBase {
     TerminalNode* AddBasicModifier(const opString& modifiername, Token token);
     ValuedModifierNode* AddValueModifier(const opString& modifiername);
 
-    virtual bool HasModifier(const opString& modifiername) = NULL;
+    virtual bool HasModifier(const opSymbol& modifiername) = NULL;
     virtual bool HasModifier(Token modifiertoken) = NULL;
     virtual ValuedModifierNode* GetValuedModifier(
         const opString& modifiername) = NULL;
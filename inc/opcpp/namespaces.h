@@ -146,6 +146,7 @@ namespace delegates {}
 namespace modifiers {}
 
 class opSymbolTracker;
+class opDialectCache;
 
 using namespace modifiers;
 using namespace exceptions;
@@ -35,34 +35,38 @@ class opNodeBase {
    public:
     /**** typedefs ****/
 
-    typedef opList<opNode*>::pointer_iterator iterator;
+    typedef opNodeList::iterator iterator;
 
     /**** construction / destruction ****/
 
     // constructor
-    opNodeBase()
-        : id(T_UNKNOWN),
-          parent(NULL),
-          pos(children.Begin()),
-          line(-1),
-          file(NULL) {}
+    opNodeBase() : parent(NULL), file(NULL), id(T_UNKNOWN), line(-1) {}
 
     // destructor
     virtual ~opNodeBase();
 
+    // nodes come from the current file's arena (see opNodeArena)
+    static void* operator new(size_t size) {
+        return opNodeArena::Allocate(size);
+    }
+
+    static void operator delete(void* block, size_t size) {
+        opNodeArena::Free(block, size);
+    }
+
     // declare this in subclasses - the default constructor will always call
     // this
     void Init() {}
 
     /**** get ****/
 
-    Token GetId() { return id; }
+    Token GetId() { return (Token)id; }
 
     opNode* GetParent() { return parent; }
 
     int GetLine() { return line; }
 
-    const iterator& GetPosition() { return pos; }
+    iterator GetPosition() { return children.GetPosition(); }
 
     iterator GetBegin() { return children.Begin(); }
 
@@ -83,7 +87,12 @@ class opNodeBase {
 
     void SetParent(opNode* _parent) { parent = _parent; }
 
-    void SetLine(int _line) { line = _line; }
+    // lines past the field's range report its last line
+    void SetLine(int _line) {
+        if (_line > MaxLine) _line = MaxLine;
+
+        line = _line;
+    }
 
     void SetFile(FileNode* infile) { file = infile; }
 
@@ -91,20 +100,29 @@ class opNodeBase {
 
     void ResetPosition() {
         // if(NumChildren())
-        pos = GetBegin();
+        children.SetPosition(GetBegin());
     }
 
     // use sparingly
-    void SetPosition(iterator newpos) { pos = newpos; }
+    void SetPosition(iterator newpos) { children.SetPosition(newpos); }
 
-    void IncrementPosition() { ++pos; }
+    void IncrementPosition() {
+        iterator next = GetPosition();
+        SetPosition(++next);
+    }
 
-    void DecrementPosition() { --pos; }
+    void DecrementPosition() {
+        iterator previous = GetPosition();
+        SetPosition(--previous);
+    }
 
     bool IsEmpty() { return !HasNumChildren(1); }
 
     void ClearChildren() { children.Clear(); }
 
+    // deletes every child (and their subtrees)
+    void DeleteChildren();
+
     void CopyLineNum(opNode* n);
     void CopyFile(opNode* n);
 
@@ -132,6 +150,11 @@ class opNodeBase {
     stacked<opNode> PopFirstNode();
     stacked<opNode> PopLastNode();
 
+    // adds a node from another tree without taking it over (it keeps its
+    // parent), it has to be unshared before this is deleted
+    void ShareNode(opNode* node) { children.PushShared(node); }
+    iterator UnshareNode(iterator index) { return children.Erase(index); }
+
    private:
     void AppendNode(opNode* newChild);
     void PrependNode(opNode* newChild);
@@ -160,17 +183,26 @@ class opNodeBase {
     virtual bool Parse() { return true; }
 
    private:
-    Token id;
+    // iterators find the list a node was spliced into through its parent
+    friend class opNodeList;
+
     opNode* parent;
 
-    // list version of children stuff
-    opList<opNode*> children;
-    iterator pos;
+    // children and the position they're edited around
+    opNodeList children;
 
-    int line;
     FileNode* file;
+
+    // packed into one word, last so subclasses can use the padding after
+    // it (lines saturate at MaxLine)
+    unsigned int id : 10;
+    int line : 22;
+
+    static const int MaxLine = (1 << 21) - 1;
 };
 
+static_assert(Tokens_MAX <= 1 << 10, "opNodeBase::id is too narrow");
+
 ///
 /// opNode
 ///
@@ -426,6 +458,10 @@ class opNode : public opNodeBase {
 
     virtual FileNode* ToFileNode() { return NULL; }
 
+    // streams what the node keeps besides its children to or from a
+    // dialect cache, false if it can't be cached (see opDialectCache)
+    virtual bool CacheMembers(opDialectCache& cache) { return false; }
+
     // custom error string name
     virtual opString ErrorName() {
         if (opParameters::Get().DeveloperMode) {
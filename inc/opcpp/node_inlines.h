@@ -23,6 +23,12 @@ inline void opNodeBase::CopyFile(opNode* n) { file = n->file; }
 
 // destructor
 inline opNodeBase::~opNodeBase() {
+    DeleteChildren();
+
+    parent = NULL;
+}
+
+inline void opNodeBase::DeleteChildren() {
     iterator start = GetBegin();
     iterator end = GetEnd();
 
@@ -32,7 +38,7 @@ inline opNodeBase::~opNodeBase() {
         ++start;
     }
 
-    parent = NULL;
+    children.Clear();
 }
 
 template <class N>
@@ -79,24 +85,23 @@ inline void opNodeBase::InsertNodeAtCurrent(stacked<N>& newChild) {
 
 // inserts a node at the current position
 inline void opNodeBase::InsertNodeAtCurrent(opNode* newChild) {
-    InsertNode(newChild, pos);
+    InsertNode(newChild, GetPosition());
 }
 
 // Removes a node from the children deque at "index"
 inline void opNodeBase::RemoveNode(iterator index) {
     assert(index != GetEnd());
 
-    if (GetPosition() == index) IncrementPosition();
-
 #ifdef _DEBUG
     index->parent = NULL;
 #endif
 
+    // erasing the position moves it to the next node
     children.Erase(index);
 }
 
 // Removes node from children deque at "pos"
-inline void opNodeBase::RemoveCurrentNode() { RemoveNode(pos); }
+inline void opNodeBase::RemoveCurrentNode() { RemoveNode(GetPosition()); }
 
 // Removes first node
 inline void opNodeBase::RemoveFirstNode() { RemoveNode(GetBegin()); }
@@ -108,12 +113,9 @@ inline void opNodeBase::RemoveLastNode() { RemoveNode(GetLast()); }
 inline void opNodeBase::DeleteNode(iterator index) {
     assert(index != GetEnd());
 
-    // if we're deleting the position, our position will
-    // get invalidated, so we need to move it first
-    if (index == GetPosition()) IncrementPosition();
-
     delete *index;
 
+    // if we're deleting the position, our position moves to the next node
     children.Erase(index);
 }
 
@@ -125,7 +127,7 @@ inline void opNodeBase::DeleteNode(opNode* node) {
 }
 
 // deletes node from children deque at "pos"
-inline void opNodeBase::DeleteCurrentNode() { DeleteNode(pos); }
+inline void opNodeBase::DeleteCurrentNode() { DeleteNode(GetPosition()); }
 
 // deletes first node
 inline void opNodeBase::DeleteFirstNode() { DeleteNode(GetBegin()); }
@@ -155,7 +157,9 @@ inline stacked<opNode> opNodeBase::PopNode(iterator index) {
     return stacked<opNode>(popped);
 }
 
-inline stacked<opNode> opNodeBase::PopCurrentNode() { return PopNode(pos); }
+inline stacked<opNode> opNodeBase::PopCurrentNode() {
+    return PopNode(GetPosition());
+}
 
 inline stacked<opNode> opNodeBase::PopFirstNode() {
     return PopNode(GetBegin());
@@ -179,8 +183,8 @@ inline void opNodeBase::MoveNodes(iterator index, opNode* node, iterator start,
 // general collapse node method, deletes the node
 template <class N>
 inline void opNodeBase::CollapseNode(stacked<N>& collapse, iterator index) {
-    iterator it = collapse->children.begin();
-    iterator end = collapse->children.end();
+    iterator it = collapse->GetBegin();
+    iterator end = collapse->GetEnd();
 
     while (it != end) {
         it->parent = (opNode*)this;
@@ -194,20 +198,20 @@ inline void opNodeBase::CollapseNode(stacked<N>& collapse, iterator index) {
 // drops all the nodes contents at the current position
 template <class N>
 inline void opNodeBase::CollapseNodeAtCurrent(stacked<N>& collapse) {
-    CollapseNode(collapse, pos);
+    CollapseNode(collapse, GetPosition());
 }
 
 // returns current node
 inline opNode* opNodeBase::CurrentNode() {
-    assert(pos != GetEnd());
+    assert(GetPosition() != GetEnd());
 
-    return *pos;
+    return *GetPosition();
 }
 
 // returns current node, or null
 // do not call in empty nodes!
 inline opNode* opNodeBase::PreviousNode() {
-    iterator lastpos = pos;
+    iterator lastpos = GetPosition();
 
     if (lastpos == GetBegin()) return NULL;
 
@@ -3324,20 +3328,26 @@ inline T* FileNode::Load(const opString& file, opScanner::ScanMode scanmode,
     opScanner scanner;
     T* rootNode = NULL;
 
-    // try to get the node from the loaded file table if possible
-    // NOTE: disabled caching for now
-    rootNode = NULL;  //(T*)GetLoadedFile(file);
-
-    if (rootNode) return rootNode;
+    // NOTE: loaded file nodes are never shared, an included file becomes
+    //		 a child of its include node (sharing one gave it several
+    //		 parents and freed it twice).  included files share their
+    //		 scanned tokens instead and each include builds its own tree.
 
     double totaltimestart = opTimer::GetTimeSeconds();
 
-    // try to open the file
-    // ifs.open(file);
-    FileReadStream ifs(file);
+    opTraceScope trace;
+    if (opTrace::IsEnabled())
+        trace.Begin(opString(bIncluded ? "Include " : "Load ") + file, "file");
 
     rootNode = *NEWNODE(T());
 
+    // a loaded file's tree is allocated from its own arena, included files
+    // become part of the including file's tree
+    if (!bIncluded) rootNode->Arena = new opNodeArena;
+
+    opNodeArena::Scope arenascope(bIncluded ? opNodeArena::GetCurrent()
+                                            : rootNode->Arena);
+
     // fix up the inputname
     path filepath = file.GetString();
     filepath.normalize();
@@ -3348,7 +3358,7 @@ inline T* FileNode::Load(const opString& file, opScanner::ScanMode scanmode,
 
     // TODO: probably not correct - this is really ugly too.
     if (!rootNode->bAbsolutePath) {
-        path abspath = initial_path() / rootNode->InputName.GetString();
+        path abspath = current_path() / rootNode->InputName.GetString();
         abspath.normalize();
 
         rootNode->AbsoluteFileName = abspath.string();
@@ -3358,49 +3368,93 @@ inline T* FileNode::Load(const opString& file, opScanner::ScanMode scanmode,
     // add it to the loaded file table
     if (!bIncluded) FileTable.push_back(rootNode);
 
-    if (!ifs.IsOpen()) {
-        return rootNode;
-    }
+    // included files are only scanned once per run
+    const opScanner::ScannedFile* scanned = NULL;
 
-    // now scan with timing
-    double scantimestart = opTimer::GetTimeSeconds();
-    bool bScanError = !scanner.Scan(ifs, scanmode, rootNode);
-    double scantimeend = opTimer::GetTimeSeconds();
+    if (bIncluded)
+        scanned = opScanner::FindScanned(rootNode->InputName, scanmode);
 
-    rootNode->scanMs = (scantimeend - scantimestart) * 1000.0;
+    if (scanned)
+        opScanner::AddTokensToRoot(scanned->Tokens, scanned->Buffer,
+                                   rootNode);
+    else {
+        // try to open the file
+        FileReadStream ifs(file);
 
-    // scanner error? end this.
-    if (bScanError) {
-        return rootNode;
+        if (!ifs.IsOpen()) {
+            return rootNode;
+        }
+
+        // now scan with timing
+        opTraceScope scantrace("Scan", "phase");
+        double scantimestart = opTimer::GetTimeSeconds();
+        bool bScanError = !scanner.Scan(ifs, scanmode, rootNode);
+        double scantimeend = opTimer::GetTimeSeconds();
+        scantrace.End();
+
+        rootNode->scanMs = (scantimeend - scantimestart) * 1000.0;
+
+        // scanner error? end this.
+        if (bScanError) {
+            return rootNode;
+        }
+
+        scanner.AddTokensToRoot(rootNode);
+
+        opBenchmark::CountTokens(scanner.GetTokens().Size());
+
+        if (bIncluded && !opError::HasErrors())
+            opScanner::StoreScanned(rootNode->InputName, scanmode,
+                                    scanner.GetBuffer(), scanner.GetTokens());
     }
 
-    scanner.AddTokensToRoot(rootNode);
+    // -benchmark scan only measures the scanner
+    if (opBenchmark::GetMode() == opBenchmark::Scan &&
+        scanmode == opScanner::SM_NormalMode)
+        return rootNode;
 
     double parsetimestart = opTimer::GetTimeSeconds();
 
+    // each phase is a trace span (the scope ends it on failure)
+    opTraceScope phase("Preprocessor", "phase");
+
     // preprocessor
     if (!rootNode->Preprocessor()) return rootNode;
 
+    phase.Next("PreProcess", "phase");
+
     // pre process
     if (!rootNode->PreProcess()) return rootNode;
 
     if (!bIncluded) {
+        phase.Next("PreOperations", "phase");
+
         // pre operations
         if (!rootNode->PreOperations()) return rootNode;
 
+        phase.Next("Process", "phase");
+
         // process
         if (!rootNode->Process()) return rootNode;
 
+        phase.Next("Operations", "phase");
+
         // operations
         if (!rootNode->Operations()) return rootNode;
 
+        phase.Next("PostProcess", "phase");
+
         // post process
         if (!rootNode->PostProcess()) return rootNode;
 
+        phase.Next("PostOperations", "phase");
+
         // post operations
         if (!rootNode->PostOperations()) return rootNode;
     }
 
+    phase.End();
+
     double parsetimeend = opTimer::GetTimeSeconds();
     rootNode->parseMs = (parsetimeend - parsetimestart) * 1000.0;
 
@@ -0,0 +1,349 @@
+///****************************************************************
+/// Copyright  2008 opGames LLC - All Rights Reserved
+///
+/// Authors: Kevin Depue & Lucas Ellis
+///
+/// File: opNodeList.h
+/// Date: 10/17/2026
+///
+/// Description:
+///
+/// Child storage for opNodes.
+///****************************************************************
+
+namespace nodes {
+
+class opNode;
+
+///
+/// opNodeList
+///
+
+// A gap buffer of child pointers, with the node's parsing position.  The
+// parser rewrites a node's children around its position, so the gap
+// follows the last edit and inserting or erasing at the position doesn't
+// move anything.  The buffer and its bookkeeping are one block from the
+// node arena, so the list itself is a pointer, and nodes without children
+// (most of them - terminals) share a static empty block.
+//
+// Iterators stay valid like list iterators: each remembers its node, and
+// if moving the gap has shifted it, it finds the node again (nearby, since
+// the node's index rarely changes by more than the edits near it).  An
+// iterator whose node was spliced into another list follows it there,
+// through the node's parent.  Erasing a node still invalidates iterators
+// to it.
+class opNodeList {
+   public:
+    class iterator {
+       public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef opNode* value_type;
+        typedef ptrdiff_t difference_type;
+        typedef opNode** pointer;
+        typedef opNode* reference;
+
+        iterator() : List(NULL), Index(0), Node(NULL) {}
+
+        opNode* operator*() const { return Node; }
+
+        opNode* operator->() const { return Node; }
+
+        iterator& operator++() {
+            List->Next(*this);
+            return *this;
+        }
+
+        iterator& operator--() {
+            List->Previous(*this);
+            return *this;
+        }
+
+        iterator operator++(int) {
+            iterator old = *this;
+            List->Next(*this);
+            return old;
+        }
+
+        iterator operator--(int) {
+            iterator old = *this;
+            List->Previous(*this);
+            return old;
+        }
+
+        // a node is only ever in one list once
+        bool operator==(const iterator& other) const {
+            return Node == other.Node;
+        }
+
+        bool operator!=(const iterator& other) const {
+            return Node != other.Node;
+        }
+
+       private:
+        friend class opNodeList;
+
+        iterator(opNodeList* list, int index, opNode* node)
+            : List(list), Index(index), Node(node) {}
+
+        opNodeList* List;
+
+        // slot + 1 before the gap, slot - capacity after it, 0 at the end
+        // (so growing the array doesn't move either side)
+        mutable int Index;
+
+        // NULL at the end
+        opNode* Node;
+    };
+
+    /**** construction / destruction ****/
+
+    opNodeList() : Items(&Empty) {}
+
+    ~opNodeList() { Release(); }
+
+    /**** get ****/
+
+    iterator Begin() {
+        Block* items = Items;
+
+        if (items->GapStart) return iterator(this, 1, items->Slots[0]);
+
+        if (items->GapEnd == items->Capacity) return End();
+
+        return iterator(this, items->GapEnd - items->Capacity,
+                        items->Slots[items->GapEnd]);
+    }
+
+    iterator Last() { return At(Size() - 1); }
+
+    iterator End() { return iterator(this, 0, NULL); }
+
+    int Size() const {
+        return Items->GapStart + Items->Capacity - Items->GapEnd;
+    }
+
+    bool IsEmpty() const { return Size() == 0; }
+
+    bool HasSize(int num) const { return Size() >= num; }
+
+    iterator Find(opNode* node);
+
+    iterator GetPosition() {
+        return iterator(this, Items->PositionIndex, Items->Position);
+    }
+
+    /**** set ****/
+
+    void SetPosition(const iterator& it) {
+        // the empty block is shared, and its position is always the end
+        if (Items == &Empty) return;
+
+        Items->PositionIndex = it.Index;
+        Items->Position = it.Node;
+    }
+
+    /**** utility ****/
+
+    void PushBack(opNode* node) {
+        Block* items = Items;
+
+        if (items->GapEnd == items->Capacity && items->GapStart < items->GapEnd)
+            items->Slots[items->GapStart++] = node;
+        else
+            Insert(End(), node);
+    }
+
+    void PushFront(opNode* node) { Insert(Begin(), node); }
+
+    // appends a node whose parent is another list's
+    void PushShared(opNode* node) {
+        PushBack(node);
+        Items->bShared = true;
+    }
+
+    void Insert(const iterator& before, opNode* node);
+
+    // returns the iterator after the erased node (erasing the position
+    // moves it there too)
+    iterator Erase(const iterator& position);
+
+    void Clear();
+
+    // moves [first,last) from another list to before 'before'
+    void Splice(const iterator& before, opNodeList& from,
+                const iterator& first, const iterator& last);
+
+    void Splice(const iterator& before, opNodeList& from) {
+        Splice(before, from, from.Begin(), from.End());
+    }
+
+   private:
+    struct Block {
+        int GapStart;
+        int GapEnd;
+        int Capacity : 31;
+
+        // holds shared nodes, so a node whose parent is elsewhere may
+        // still be here
+        unsigned int bShared : 1;
+
+        // the position as an iterator (kept current when the gap moves)
+        int PositionIndex;
+        opNode* Position;
+
+        // Capacity of them
+        opNode* Slots[1];
+    };
+
+    int SlotOf(int index) const {
+        return index < Items->GapStart
+                   ? index
+                   : index + Items->GapEnd - Items->GapStart;
+    }
+
+    int Encode(int slot) const {
+        return slot < Items->GapStart ? slot + 1 : slot - Items->Capacity;
+    }
+
+    iterator At(int index) {
+        if (index < 0 || index >= Size()) return End();
+
+        int slot = SlotOf(index);
+
+        return iterator(this, Encode(slot), Items->Slots[slot]);
+    }
+
+    // the iterator's index in the list (Size() at the end)
+    int IndexOf(const iterator& it) {
+        Block* items = Items;
+
+        if (!it.Node) return Size();
+
+        if (it.Index > 0) {
+            int slot = it.Index - 1;
+
+            if (slot < items->GapStart && items->Slots[slot] == it.Node)
+                return slot;
+        } else {
+            int slot = items->Capacity + it.Index;
+
+            if (slot >= items->GapEnd && items->Slots[slot] == it.Node)
+                return slot - (items->GapEnd - items->GapStart);
+        }
+
+        return Relocate(it);
+    }
+
+    void Next(iterator& it) {
+        Block* items = Items;
+        int index = it.Index;
+
+        // usually the next node is on the same side of the gap, or just
+        // across it
+        if (index > 0) {
+            if (index <= items->GapStart &&
+                items->Slots[index - 1] == it.Node) {
+                if (index < items->GapStart) {
+                    it.Index = index + 1;
+                    it.Node = items->Slots[index];
+                } else if (items->GapEnd < items->Capacity) {
+                    it.Index = items->GapEnd - items->Capacity;
+                    it.Node = items->Slots[items->GapEnd];
+                } else {
+                    it = End();
+                }
+
+                return;
+            }
+        } else if (index < 0) {
+            int slot = items->Capacity + index;
+
+            if (slot >= items->GapEnd && items->Slots[slot] == it.Node) {
+                if (index < -1) {
+                    it.Index = index + 1;
+                    it.Node = items->Slots[slot + 1];
+                } else {
+                    it = End();
+                }
+
+                return;
+            }
+        }
+
+        Step(it, 1);
+    }
+
+    void Previous(iterator& it) {
+        Block* items = Items;
+        int index = it.Index;
+
+        // the same, backwards (the end steps back to the last node)
+        if (index > 1) {
+            if (index <= items->GapStart &&
+                items->Slots[index - 1] == it.Node) {
+                it.Index = index - 1;
+                it.Node = items->Slots[index - 2];
+                return;
+            }
+        } else if (index < 0) {
+            int slot = items->Capacity + index;
+
+            if (slot >= items->GapEnd && items->Slots[slot] == it.Node) {
+                if (slot > items->GapEnd) {
+                    it.Index = index - 1;
+                    it.Node = items->Slots[slot - 1];
+                    return;
+                }
+
+                if (items->GapStart) {
+                    it.Index = items->GapStart;
+                    it.Node = items->Slots[items->GapStart - 1];
+                    return;
+                }
+            }
+        } else if (index == 0 && !it.Node) {
+            if (items->GapEnd < items->Capacity) {
+                it.Index = -1;
+                it.Node = items->Slots[items->Capacity - 1];
+                return;
+            }
+
+            if (items->GapStart) {
+                it.Index = items->GapStart;
+                it.Node = items->Slots[items->GapStart - 1];
+                return;
+            }
+        }
+
+        Step(it, -1);
+    }
+
+    // moves an iterator by one the slow way (following its node if it
+    // was spliced into another list)
+    void Step(iterator& it, int offset);
+
+    // the list a node is in, through its parent (NULL without one)
+    static opNodeList* ListOf(opNode* node);
+
+    // finds a node the gap has moved past, -1 if it isn't here
+    int Search(const iterator& it);
+
+    // the same, for nodes that must be here
+    int Relocate(const iterator& it);
+
+    void MoveGap(int index);
+    void Reserve(int count);
+    void Release();
+
+    /*=== data ===*/
+
+    Block* Items;
+
+    static Block Empty;
+
+    // not copyable
+    opNodeList(const opNodeList&);
+    opNodeList& operator=(const opNodeList&);
+};
+
+}  // end namespace nodes
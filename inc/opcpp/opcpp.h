@@ -15,8 +15,10 @@
 
 // system
 #include <time.h>
+#include <atomic>
 #include <fstream>
 #include <iomanip>
+#include <memory>
 
 // configuration
 #include "opcpp/config.h"
@@ -30,16 +32,21 @@
 #include <boost/filesystem/fstream.hpp>
 #include <boost/filesystem/operations.hpp>
 #include <boost/filesystem/path.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
 using boost::filesystem::path;
 
 // opcpp
 #include "opcpp/basic_nodes.h"
+#include "opcpp/benchmark.h"
 #include "opcpp/beta.h"
 #include "opcpp/code_visitors.h"
 #include "opcpp/contexts.h"
 #include "opcpp/contexts_inlines.h"
 #include "opcpp/delegates.h"
 #include "opcpp/demo.h"
+#include "opcpp/dialect_cache.h"
 #include "opcpp/dialect_interfaces.h"
 #include "opcpp/dialect_interfaces_inlines.h"
 #include "opcpp/dialect_modifier_nodes.h"
@@ -64,6 +71,7 @@ using boost::filesystem::path;
 #include "opcpp/macro_interfaces_inlines.h"
 #include "opcpp/macro_nodes.h"
 #include "opcpp/macros.h"
+#include "opcpp/manifest.h"
 #include "opcpp/mappings.h"
 #include "opcpp/memory_tracker.h"
 #include "opcpp/modifier_interfaces.h"
@@ -73,15 +81,20 @@ using boost::filesystem::path;
 #include "opcpp/namespaces.h"
 #include "opcpp/node.h"
 #include "opcpp/node_inlines.h"
+#include "opcpp/node_list.h"
 #include "opcpp/parameters.h"
+#include "opcpp/path_cache.h"
 #include "opcpp/paths.h"
 #include "opcpp/platforms.h"
 #include "opcpp/regex_support.h"
 #include "opcpp/scanner.h"
+#include "opcpp/server.h"
+#include "opcpp/socket_support.h"
 #include "opcpp/statement_interfaces.h"
 #include "opcpp/statement_interfaces_inlines.h"
 #include "opcpp/statement_nodes.h"
 #include "opcpp/stream.h"
+#include "opcpp/symbol_table.h"
 #include "opcpp/symbol_tracker.h"
 #include "opcpp/time.h"
 #include "opcpp/timer.h"
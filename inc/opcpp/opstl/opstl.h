@@ -18,6 +18,7 @@
 #include "opcpp/opstl/hash.h"
 #include "opcpp/opstl/list.h"
 #include "opcpp/opstl/map.h"
+#include "opcpp/opstl/perfect_hash.h"
 #include "opcpp/opstl/set.h"
 #include "opcpp/opstl/string.h"
 #include "opcpp/opstl/wide_string.h"
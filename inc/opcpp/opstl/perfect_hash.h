@@ -0,0 +1,145 @@
+//****************************************************************
+// Copyright  2008 opGames Inc. - All Rights Reserved
+//
+// Authors: Kevin Depue & Lucas Ellis
+//
+// File: opPerfectHash.h
+// Date: 10/17/2026
+//
+// Description:
+//
+// Lookup table for a fixed set of string keys.
+//****************************************************************
+
+#pragma once
+
+#include <assert.h>
+#include <string.h>
+#include "opcpp/opstl/array.h"
+#include "opcpp/opstl/opstlcommon.h"
+#include "opcpp/opstl/string.h"
+
+namespace opstl {
+
+//==========================================
+// opPerfectHash
+//==========================================
+
+// Insert all the keys, then Build() searches for a hash seed that gives
+// every key its own slot.  A lookup is then one hash and one compare,
+// and text longer than the longest key isn't hashed at all.
+template <class Value>
+class opPerfectHash {
+   public:
+    /**** construction ****/
+
+    opPerfectHash() : Mask(0), Seed(0), MaxLength(0) {}
+
+    /**** utility ****/
+
+    // like opHashTable, the first value inserted for a key wins
+    void Insert(const opString& key, const Value& value) {
+        if (Keys.Find(key) != Keys.End()) return;
+
+        Keys.PushBack(key);
+        Values.PushBack(value);
+
+        if (key.Length() > MaxLength) MaxLength = key.Length();
+    }
+
+    // returns false if no seed was found (lookups then always fail)
+    bool Build() {
+        int count = Keys.Size();
+        int size = 1;
+
+        // a slot holds a key index + 1 in an unsigned short
+        if (count > 65535) {
+            assert(0 && "too many keys for opPerfectHash");
+            return false;
+        }
+
+        // collisions are likely until there are about n^2 / 8 slots
+        while (size < count * 4 || size * 8 < count * count) size <<= 1;
+
+        for (; size <= 65536; size <<= 1) {
+            Slots.Clear();
+            Slots.AddZeroed(size);
+
+            for (unsigned int seed = 1; seed <= 1024; seed++) {
+                if (TrySeed(seed)) return true;
+            }
+        }
+
+        Slots.Clear();
+
+        return false;
+    }
+
+    bool Find(const char* text, int length, Value& value) const {
+        if (length > MaxLength || Slots.IsEmpty()) return false;
+
+        int index = Slots[(int)(Hash(text, length, Seed) & Mask)];
+
+        if (!index) return false;
+
+        const opString& key = Keys[index - 1];
+
+        if (key.Length() != length ||
+            memcmp(key.GetCString(), text, length) != 0)
+            return false;
+
+        value = Values[index - 1];
+
+        return true;
+    }
+
+    bool Find(const opString& key, Value& value) const {
+        return Find(key.GetCString(), key.Length(), value);
+    }
+
+    int Size() const { return Keys.Size(); }
+
+   private:
+    // fnv-1a, seeded
+    static unsigned int Hash(const char* text, int length, unsigned int seed) {
+        unsigned int h = 2166136261u ^ (seed * 0x9e3779b9u);
+
+        for (int i = 0; i < length; i++) {
+            h ^= (unsigned char)text[i];
+            h *= 16777619u;
+        }
+
+        return h ^ (h >> 16);
+    }
+
+    bool TrySeed(unsigned int seed) {
+        unsigned int mask = Slots.Size() - 1;
+
+        memset(&Slots[0], 0, Slots.MemSize());
+
+        for (int i = 0; i < Keys.Size(); i++) {
+            const opString& key = Keys[i];
+            int slot = (int)(Hash(key.GetCString(), key.Length(), seed) & mask);
+
+            if (Slots[slot]) return false;
+
+            Slots[slot] = (unsigned short)(i + 1);
+        }
+
+        Mask = mask;
+        Seed = seed;
+
+        return true;
+    }
+
+    opArray<opString> Keys;
+    opArray<Value> Values;
+
+    // key index + 1 for each slot, 0 if empty
+    opArray<unsigned short> Slots;
+    unsigned int Mask;
+    unsigned int Seed;
+    int MaxLength;
+};
+
+}  // namespace opstl
@@ -235,7 +235,7 @@ class opIntOption : public opOption {
 ///==========================================
 
 class opParameters {
-    friend class opDriver;
+    friend class ::opDriver;
     friend class lobber;
 
    public:
@@ -248,6 +248,9 @@ class opParameters {
 
     static void Destroy();
 
+    // compile jobs read their own copy of the parameters (NULL to stop)
+    static void SetJobInstance(opParameters* params) { JobInstance = params; }
+
     /**** startup ****/
 
     // read command-line arguments (Params)
@@ -313,9 +316,15 @@ class opParameters {
     opBoolOption Highlighting;
     opBoolOption Notations;
     opBoolOption PrintXml;
+    opBoolOption Depfiles;
     opIntOption OPMacroExpansionDepth;
     opBoolOption FixedSys;
     opListOption Depend;
+    opIntOption Jobs;
+    opStringOption Server;
+    opStringOption Connect;
+    opIntOption GlobShards;
+    opStringOption Trace;
 
     /*=== debug options (these options are hidden) ===*/
 
@@ -323,6 +332,8 @@ class opParameters {
     opBoolOption PrintFullTree;
     bool NormalMode;
     opBoolOption DeveloperMode;
+    opStringOption Benchmark;
+    opBoolOption DispatchParse;
 
    private:
     friend class opOption;
@@ -333,6 +344,7 @@ class opParameters {
     static vector<opOption*> Options;
 
     static opParameters* Instance;
+    static THREAD_LOCAL opParameters* JobInstance;
 };
 
 }  // end namespace parameters
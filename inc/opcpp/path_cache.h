@@ -0,0 +1,66 @@
+///****************************************************************
+/// Copyright  2008 opGames LLC - All Rights Reserved
+///
+/// Authors: Kevin Depue & Lucas Ellis
+///
+/// File: PathCache.h
+/// Date: 10/17/2026
+///
+/// Description:
+///
+/// Per-run filesystem metadata cache.
+///****************************************************************
+
+///==========================================
+/// opPathCache
+///==========================================
+
+// Remembers stat results and opinclude resolutions for one driver
+// run, so repeated lookups of the same input paths (validation, every
+// -d directory probed per opinclude, dependency checks) only touch the
+// filesystem once.  Only use it for inputs - generated files change
+// during a run.
+class opPathCache {
+   public:
+    // forgets everything (start of a run)
+    static void Reset();
+
+    static bool Exists(const path& p);
+
+    // 0 if the file doesn't exist
+    static time_t LastWriteTime(const path& p);
+
+    // resolved opinclude paths, keyed by including directory and
+    // the include string
+    static bool FindInclude(const opString& directory,
+                            const opString& include, opString& resolved);
+    static void StoreInclude(const opString& directory,
+                             const opString& include,
+                             const opString& resolved);
+
+    // writes the hit counters to the log
+    static void LogCounters();
+
+   private:
+    struct Entry {
+        Entry() : bExists(false), bTime(false), Time(0) {}
+
+        bool bExists;
+        bool bTime;
+        time_t Time;
+    };
+
+    static Entry Stat(const path& p, bool btime);
+
+    /*=== data ===*/
+
+    static opMap<opString, Entry> Entries;
+    static opMap<opString, opString> Includes;
+    static boost::mutex Mutex;
+
+    // counters
+    static int Stats;
+    static int StatHits;
+    static int IncludeLookups;
+    static int IncludeHits;
+};
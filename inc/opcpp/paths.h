@@ -80,5 +80,5 @@ inline path to_relative_path(path p, path basepath) {
 }
 
 inline path to_relative_path(path p) {
-    return to_relative_path(p, boost::filesystem::initial_path());
+    return to_relative_path(p, boost::filesystem::current_path());
 }
@@ -22,6 +22,7 @@ class opPlatform {
     static opString GetOpCppPath();
     static opString GetOpCppDirectory();
     static time_t GetOpCppTimeStamp();
+    static long long GetPeakMemoryKb();
     static void Assertion();
     static void Breakpoint();
 
@@ -13,11 +13,14 @@
 
 namespace scanner {
 
+// a post scanning pass (see scanner.cpp)
+class opTokenStage;
+
 class opScanner {
    public:
     /**** construction / destruction ****/
 
-    opScanner() : ScanComplete(false) {}
+    opScanner() : ScanComplete(false), Stages(NULL) {}
     virtual ~opScanner() {}
 
     /**** enumerations ****/
@@ -34,80 +37,126 @@ class opScanner {
     void Print(ostream& o);
     void AddTokensToRoot(FileNode* infile);
 
-   private:
-    /**** private utility ****/
+    const opArray<opToken>& GetTokens() const { return Tokens; }
 
-    typedef opArray<char> inputtype;
-    typedef inputtype::iterator inputiterator;
+    const opSourceBuffer& GetBuffer() const { return Buffer; }
 
-    void FixNewlines(inputtype& Input);
-    template <Token Type, Token Replacement>
-    bool FixAltPrefix(opList<opToken>::iterator& start, TerminalNode* name);
+    // code file terminals keep viewing the buffer, others copy their text
+    static void AddTokensToRoot(const opArray<opToken>& tokens,
+                                const opSourceBuffer& buffer,
+                                FileNode* infile);
 
-    // scanning
-    void ScanTokens(const inputtype& Input);
-    bool Newline(const inputtype& Input, int& index);
-    bool CComment(const inputtype& Input, int& index);
-    bool Comment(const inputtype& Input, int& index);
-    bool WhiteSpace(const inputtype& Input, int& index);
-    bool String(const inputtype& Input, int& index);
-    bool Operator(const inputtype& Input, int& index);
-    bool Hexadecimals(const inputtype& Input, int& index);
-    bool Number(const inputtype& Input, int& index);
-    bool GetId(const inputtype& Input, int& index);
-
-    // post scanning
-    void Preprocessor();
-    void FixStrings();
-    void Keyword();
-    void BasicType();
-    void UserDefined();
-    void ContinueLines();
-    void Decimals();
-    void WideStrings();
-    void FixNumbers();
-    void CPlusPlus();
-
-    /**** private helper utility ****/
+    /**** scanned file cache ****/
 
-    // returns true if the token is a float/long specifier (f, F, l, L)
-    bool IsFloatFlagToken(const opToken& tok) {
-        return tok.Id == T_ID && (tok.Value.Size() == 1) &&
-               IsFloatChar(tok.Value.Front());
-    }
+    // opincluded files keep their tokens for one run, so a file included
+    // from many places is only read and scanned once (entries stay put
+    // until ClearScanned, which only runs between conversions)
+    struct ScannedFile {
+        opSourceBuffer Buffer;
+        opArray<opToken> Tokens;
+    };
 
-    // returns true if the token is a decimal and it doesn't have a float
-    // specifier
-    bool IsBareDecimal(const opToken& tok) {
-        return tok.Id == T_DECIMAL && !IsFloatChar(tok.Value.Back());
-    }
+    static const ScannedFile* FindScanned(const opString& file, ScanMode mode);
+    static void StoreScanned(const opString& file, ScanMode mode,
+                             const opSourceBuffer& buffer,
+                             const opArray<opToken>& tokens);
+    static void ClearScanned();
 
-    bool IsExpID(const opToken& tok);
+   private:
+    /**** private utility ****/
 
-    // returns true if the token is a T_ID and is either "e" or "E"
-    bool IsExpToken(const opToken& tok) {
-        return tok.Id == T_ID && (tok.Value.Size() == 1) &&
-               IsExpChar(tok.Value.Front());
-    }
+    typedef FileBuffer inputtype;
 
-    // returns true if the token is either + or -
-    bool IsSignToken(const opToken& tok) {
-        return tok.Id == T_PLUS || tok.Id == T_MINUS;
-    }
+    // scanning
+    void ScanTokens(inputtype& Input);
+
+    // the scanners in precedence order
+    enum ScanOrder {
+        SO_Newline,
+        SO_CComment,
+        SO_Comment,
+        SO_String,
+        SO_WhiteSpace,
+        SO_Operator,
+        SO_Hexadecimals,
+        SO_Number,
+        SO_GetId,
+    };
+
+    // tries the scanners from first on, the first byte picks where
+    // ScanTokens starts so it doesn't have to try them all
+    void ScanInOrder(inputtype& Input, size_t& index, ScanOrder first);
+
+    bool Newline(inputtype& Input, size_t& index);
+    bool CComment(inputtype& Input, size_t& index);
+    bool Comment(inputtype& Input, size_t& index);
+    bool WhiteSpace(inputtype& Input, size_t& index);
+    bool String(inputtype& Input, size_t& index);
+    bool Operator(inputtype& Input, size_t& index);
+    bool Hexadecimals(inputtype& Input, size_t& index);
+    bool Number(inputtype& Input, size_t& index);
+    bool GetId(inputtype& Input, size_t& index);
+
+    // post scanning, each scanned token goes through the stages
+    void Emit(opToken token);
 
    private:
     // opDeque<char>    Input;
-    opList<opToken> Tokens;
+    opSourceBuffer Buffer;
+    opArray<opToken> Tokens;
+    opTokenStage* Stages;
     bool ScanError;
     int CurrentLine;
     bool ScanComplete;
     ScanMode scanMode;
     opNode* Root;
 
+    static opMap<opString, ScannedFile> Scanned;
+    static boost::mutex ScannedMutex;
+
+    /**** character types ****/
+
+    enum CharType {
+        CT_NEWLINE = 0x01,
+        CT_WHITESPACE = 0x02,
+        CT_DIGIT = 0x04,
+        CT_ALPHA = 0x08,
+        CT_HEXDIGIT = 0x10,
+        CT_OPERATOR = 0x20,
+        CT_QUOTE = 0x40,
+        CT_UNDERSCORE = 0x80,
+    };
+
+    // types of each character, indexed by unsigned char
+    static const unsigned char CharTypes[256];
+
+    static bool IsType(char c, int types) {
+        return (CharTypes[(unsigned char)c] & types) != 0;
+    }
+
+    // runs of characters (16 at a time with sse2), these return the
+    // index of the first character that ends the run, or end
+    static size_t SkipWhiteSpace(char* text, size_t index, size_t end);
+    static size_t SkipIdChars(const char* text, size_t index, size_t end);
+    static size_t FindAny(const char* text, size_t index, size_t end, char a,
+                          char b, char c);
+
+    // the '\r' of "\r\n" scans as a space, so it's changed to one in
+    // place when the scanner reaches it (the tokens view the text)
+    static bool SpaceCR(char* text, size_t index, size_t end) {
+        if (text[index] != '\r' || index + 1 >= end ||
+            text[index + 1] != '\n')
+            return false;
+
+        text[index] = ' ';
+
+        return true;
+    }
+
    public:
     /**** static utility ****/
 
-    static bool IsNewline(char c) { return c == '\n' || c == '\r'; }
+    static bool IsNewline(char c) { return IsType(c, CT_NEWLINE); }
 
     static bool IsExpChar(char c) { return c == 'e' || c == 'E'; }
 
@@ -115,90 +164,106 @@ class opScanner {
         return c == 'f' || c == 'F' || c == 'l' || c == 'L';
     }
 
-    static bool IsWhiteSpace(char c) { return (c == ' ' || c == '\t'); }
+    static bool IsWhiteSpace(char c) { return IsType(c, CT_WHITESPACE); }
 
-    static bool IsDigit(char c) {
-        int i = c;
+    static bool IsDigit(char c) { return IsType(c, CT_DIGIT); }
 
-        return (i > 47 && i < 58);
-    }
+    static bool IsAlpha(char c) { return IsType(c, CT_ALPHA); }
 
-    static bool IsAlpha(char c) {
-        int i = c;
+    static bool IsAlphaNum(char c) { return IsType(c, CT_ALPHA | CT_DIGIT); }
 
-        return (i > 96 && i < 123) || (i > 64 && i < 91);
+    static bool IsIdChar(char c) {
+        return IsType(c, CT_ALPHA | CT_DIGIT | CT_UNDERSCORE);
     }
 
-    static bool IsAlphaNum(char c) { return IsAlpha(c) || IsDigit(c); }
-
-    static bool IsOperatorChar(char c) {
-        return (c == '+' || c == '-' || c == '*' || c == '/' || c == '<' ||
-                c == '>' || c == '^' || c == '=' || c == '?' || c == '(' ||
-                c == ')' || c == '[' || c == ']' || c == '{' || c == '}' ||
-                c == '&' || c == '.' || c == ',' || c == ':' || c == ';' ||
-                c == '%' || c == '!' || c == '|' || c == '~' || c == '#' ||
-                c == '\\' || c == '`');
-    }
+    static bool IsOperatorChar(char c) { return IsType(c, CT_OPERATOR); }
 
     static bool IsPreprocessorKeyword(const opString& s) {
-        if (s == "define" || s == "elif" || s == "else" || s == "endif" ||
-            s == "error" || s == "if" || s == "ifdef" || s == "ifndef" ||
-            s == "import" || s == "include" || s == "line" || s == "pragma" ||
-            s == "undef" || s == "using" || s == "warning") {
-            return true;
-        }
+        return IsWord(s, WC_PREPROCESSOR);
+    }
 
-        return false;
+    static bool IsPreprocessorKeyword(const opToken& t) {
+        return IsWord(t, WC_PREPROCESSOR);
     }
 
     static bool IsStandardBasicType(const opString& s) {
-        if (s == "char" || s == "bool" || s == "short" || s == "long" ||
-            s == "float" || s == "double" || s == "wchar_t" || s == "int" ||
-            s == "void" || s == "long long" || s == "long double") {
-            return true;
-        }
-
-        return false;
+        return IsWord(s, WC_STANDARD_BASIC_TYPE);
     }
 
     static bool IsMicrosoftBasicType(const opString& s) {
-        if (s == "__wchar_t" || s == "__int8" || s == "__int16" ||
-            s == "__int32" || s == "__int64") {
-            return true;
-        }
-
-        return false;
+        return IsWord(s, WC_MICROSOFT_BASIC_TYPE);
     }
 
     static bool IsBasicType(const opString& s) {
-        return IsStandardBasicType(s) || IsMicrosoftBasicType(s);
+        return IsWord(s, WC_STANDARD_BASIC_TYPE | WC_MICROSOFT_BASIC_TYPE);
+    }
+
+    static bool IsBasicType(const opToken& t) {
+        return IsWord(t, WC_STANDARD_BASIC_TYPE | WC_MICROSOFT_BASIC_TYPE);
     }
 
     static bool IsSignable(const opString& s) {
-        return (s == "char" || s == "short" || s == "long" || s == "int" ||
-                s == "__int8" || s == "__int16" || s == "__int32" ||
-                s == "__int64");
+        return IsWord(s, WC_SIGNABLE);
     }
 
-    static bool IsHexDigit(char c) {
-        int i = c;
+    static bool IsHexDigit(char c) { return IsType(c, CT_HEXDIGIT); }
 
-        return (i > 47 && i < 58) || (i > 96 && i < 103) || (i > 64 && i < 71);
+    // returns true if the token is a float/long specifier (f, F, l, L)
+    static bool IsFloatFlagToken(const opToken& tok) {
+        return tok.Id == T_ID && (tok.Size() == 1) && IsFloatChar(tok.Front());
+    }
+
+    // returns true if the token is a decimal and it doesn't have a float
+    // specifier
+    static bool IsBareDecimal(const opToken& tok) {
+        return tok.Id == T_DECIMAL && !IsFloatChar(tok.Back());
+    }
+
+    static bool IsExpID(const opToken& tok);
+
+    // returns true if the token is a T_ID and is either "e" or "E"
+    static bool IsExpToken(const opToken& tok) {
+        return tok.Id == T_ID && (tok.Size() == 1) && IsExpChar(tok.Front());
+    }
+
+    // returns true if the token is either + or -
+    static bool IsSignToken(const opToken& tok) {
+        return tok.Id == T_PLUS || tok.Id == T_MINUS;
     }
 
     static bool IsIntegerSuffix(const opToken& t) {
-        opString s = t.Value;
-
-        return (s == "u" || s == "l" || s == "U" || s == "L" || s == "ul" ||
-                s == "lu" || s == "UL" || s == "LU" || s == "uL" || s == "Ul" ||
-                s == "lU" || s == "Lu" || s == "LL" || s == "ll" ||
-                s == "ull" || s == "uLL" || s == "Ull" || s == "ULL" ||
-                s == "i8" || s == "I8" || s == "ui8" || s == "uI8" ||
-                s == "Ui8" || s == "UI8" || s == "i16" || s == "I16" ||
-                s == "ui16" || s == "uI16" || s == "Ui16" || s == "UI16" ||
-                s == "i32" || s == "I32" || s == "ui32" || s == "uI32" ||
-                s == "Ui32" || s == "UI32" || s == "i64" || s == "I64" ||
-                s == "ui64" || s == "uI64" || s == "Ui64" || s == "UI64");
+        return IsWord(t, WC_INTEGER_SUFFIX);
+    }
+
+    // builds the word table (called by opDriver::Initialize)
+    static void InitWords();
+
+   private:
+    /**** word classes ****/
+
+    enum WordClass {
+        WC_PREPROCESSOR = 0x01,
+        WC_STANDARD_BASIC_TYPE = 0x02,
+        WC_MICROSOFT_BASIC_TYPE = 0x04,
+        WC_SIGNABLE = 0x08,
+        WC_INTEGER_SUFFIX = 0x10,
+    };
+
+    // classes of each word the scanner looks for
+    static opPerfectHash<int> Words;
+
+    static bool IsWord(const char* text, int length, int classes) {
+        int found = 0;
+
+        return Words.Find(text, length, found) && (found & classes) != 0;
+    }
+
+    static bool IsWord(const opString& s, int classes) {
+        return IsWord(s.GetCString(), s.Length(), classes);
+    }
+
+    static bool IsWord(const opToken& t, int classes) {
+        return IsWord(t.GetText(), t.Size(), classes);
     }
 };
 
@@ -0,0 +1,50 @@
+///****************************************************************
+/// Copyright  2008 opGames LLC - All Rights Reserved
+///
+/// Authors: Kevin Depue & Lucas Ellis
+///
+/// File: Server.h
+/// Date: 10/17/2026
+///
+/// Description:
+///
+/// Compile server (-server) and client (-connect).
+///****************************************************************
+
+///==========================================
+/// opCompileServer
+///==========================================
+
+// Keeps dialects loaded between compiles.  Requests and replies are
+// line based (newlines and backslashes escaped):
+//
+//   request:  cwd <directory>
+//             arg <argument> (one per argument)
+//             compile
+//
+//   reply:    log <line> (one per logged line)
+//             exit <code>
+class opCompileServer {
+   public:
+    // serves requests until the input ends
+    static int Run(const opParameters& p);
+
+    // sends this command line to a server,
+    // returns false if no server is listening
+    static bool Forward(const opParameters& p, int& exitcode);
+
+   private:
+    // handles one request, returns false when the input ends
+    bool HandleRequest(istream& in, ostream& out);
+
+    // compiles with a fresh set of parameters
+    int Compile(const opString& directory, const vector<opString>& args);
+
+    // protocol escaping
+    static string Escape(const string& s);
+    static string Unescape(const string& s);
+
+    /*=== data ===*/
+
+    opDriver Driver;
+};
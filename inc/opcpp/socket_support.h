@@ -0,0 +1,37 @@
+///****************************************************************
+/// Copyright  2008 opGames LLC - All Rights Reserved
+///
+/// Authors: Kevin Depue & Lucas Ellis
+///
+/// File: SocketSupport.h
+/// Date: 10/17/2026
+///
+/// Description:
+///
+/// Local Socket Support Wrappers
+///****************************************************************
+
+// socket support is wrapped (like regex support)
+// so asio doesn't need to be compiled so much
+
+namespace sockets {
+
+class opLocalListener;
+
+// listens on a local (unix domain) socket, a stale socket at the path is
+// replaced but any other file is left alone,
+// returns NULL (and why in error) if it fails
+opLocalListener* Listen(const opString& socketpath, opString& error);
+
+// waits for a client, the caller deletes the stream
+// returns NULL if the listener failed
+iostream* Accept(opLocalListener* listener);
+
+// stops listening
+void Close(opLocalListener* listener);
+
+// connects to a listening socket, the caller deletes the stream
+// returns NULL if nobody is listening
+iostream* Connect(const opString& socketpath);
+
+}  // namespace sockets
@@ -50,7 +50,7 @@ class StatementBase : public ConditionalSupport<opNode> {
 
     // HasModifier query
     // certain wrapping statements must overload this.
-    virtual bool HasModifier(const opString& modifiername) {
+    virtual bool HasModifier(const opSymbol& modifiername) {
         ABSTRACT_FUNCTION;
         return false;
     }
@@ -105,7 +105,7 @@ class StatementModifierlessBase : public StatementBase {
    public:
     DECLARE_NODE(StatementModifierlessBase, opNode, T_UNKNOWN);
 
-    virtual inline bool HasModifier(const opString& modifiername) {
+    virtual inline bool HasModifier(const opSymbol& modifiername) {
         return false;
     }
 
@@ -285,7 +285,7 @@ class StatementNode : public StatementNodeParent {
     bool Parse();
     bool PostParse();
 
-    virtual bool HasModifier(const opString& modifiername) {
+    virtual bool HasModifier(const opSymbol& modifiername) {
         if (GetInnerStatement())
             return GetInnerStatement()->HasModifier(modifiername);
         return false;
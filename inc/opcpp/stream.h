@@ -86,6 +86,11 @@ class opStringStream {
 
     void TrimLineEnd() { linestream = linestream.TrimRight(); }
 
+    // appends raw text to the current line
+    void Write(const char* text, int length) {
+        linestream.GetString().append(text, length);
+    }
+
     /**** operators ****/
 
     inline friend opStringStream& operator<<(opStringStream& oin,
@@ -160,13 +165,13 @@ class opStringStream {
 
     /**** data ****/
 
-    static bool ForceComments;
+    static THREAD_LOCAL bool ForceComments;
 
     FileWriteStream& of;
     int IndentLevel;
     opString IndentString;
     FileNode* InputFile;
-    static bool bLineDirectives;
+    static THREAD_LOCAL bool bLineDirectives;
 
     // we store input inside a linestream, and flush it upon endline.
     opString linestream;
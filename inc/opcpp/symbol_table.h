@@ -0,0 +1,111 @@
+///****************************************************************
+/// Copyright  2008 opGames LLC - All Rights Reserved
+///
+/// Authors: Kevin Depue & Lucas Ellis
+///
+/// File: SymbolTable.h
+/// Date: 10/17/2026
+///
+/// Description:
+///
+/// Interned identifier strings.
+///****************************************************************
+
+///==========================================
+/// opSymbol
+///==========================================
+
+// An interned string.  Every symbol with the same text shares one entry
+// for the whole run (entries are never freed), so comparing symbols is a
+// pointer compare and hashing one doesn't touch the text.
+class opSymbol {
+   public:
+    /**** construction ****/
+
+    opSymbol() : Entry(NULL) {}
+
+    // finds or adds the entry for the text (thread safe)
+    static opSymbol Intern(const char* text, int length);
+
+    static opSymbol Intern(const opString& s) {
+        return Intern(s.GetCString(), s.Length());
+    }
+
+    /**** get ****/
+
+    bool IsNull() const { return Entry == NULL; }
+
+    // the interned text, for output and errors
+    const opString& GetString() const;
+
+    // same value as opString::Hash, so tables keyed by symbols iterate in
+    // the order they did when keyed by strings
+    int Hash() const { return Entry ? Entry->Hash : 0; }
+
+    // compares against text that may not be interned (no lookup)
+    bool Equals(const char* text, int length) const {
+        return Entry && Entry->Equals(text, length, Entry->Hash);
+    }
+
+    /**** operators ****/
+
+    bool operator==(const opSymbol& other) const {
+        return Entry == other.Entry;
+    }
+
+    bool operator!=(const opSymbol& other) const {
+        return Entry != other.Entry;
+    }
+
+   private:
+    struct SymbolEntry {
+        SymbolEntry(const char* text, int length, int hash)
+            : String(string(text, length)), Hash(hash) {}
+
+        bool Equals(const char* text, int length, int hash) const {
+            return Hash == hash && String.Length() == length &&
+                   memcmp(String.GetCString(), text, length) == 0;
+        }
+
+        opString String;
+        int Hash;
+    };
+
+    explicit opSymbol(const SymbolEntry* entry) : Entry(entry) {}
+
+    static int HashText(const char* text, int length);
+    static unsigned int FirstSlot(int hash);
+
+    // the entry for the text, added if it's new (locks the table)
+    static const SymbolEntry* Find(const char* text, int length, int hash);
+
+    /*=== data ===*/
+
+    const SymbolEntry* Entry;
+
+    // open addressing, a power of two slots, at most half full
+    static opArray<const SymbolEntry*> Slots;
+    static int Count;
+    static boost::mutex Mutex;
+
+    // recently interned entries on this thread, checked without locking
+    static const int CacheSize = 1024;
+    static THREAD_LOCAL const SymbolEntry* Cache[CacheSize];
+};
+
+namespace opstl {
+
+// specialize opHasher for opSymbol as a key
+template <>
+struct opHashFunction<opSymbol> {
+    static size_t Hash(const opSymbol& t) { return (size_t)t.Hash(); }
+};
+
+template <>
+struct opHashCompare<opSymbol> {
+    static bool Compare(const opSymbol& t1, const opSymbol& t2) {
+        return t1 == t2;
+    }
+};
+
+}  // namespace opstl
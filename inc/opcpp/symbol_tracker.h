@@ -11,6 +11,43 @@
 /// Declaration of SymbolTracker class(s).
 ///****************************************************************
 
+///==========================================
+/// opMacroSignature
+///==========================================
+
+// an opmacro's name and argument count (-1 if it has no argument list)
+struct opMacroSignature {
+    opMacroSignature(const opSymbol& name, int arguments)
+        : Name(name), Arguments(arguments) {}
+
+    bool operator==(const opMacroSignature& other) const {
+        return Name == other.Name && Arguments == other.Arguments;
+    }
+
+    opSymbol Name;
+    int Arguments;
+};
+
+namespace opstl {
+
+// specialize opHasher for opMacroSignature as a key
+template <>
+struct opHashFunction<opMacroSignature> {
+    static size_t Hash(const opMacroSignature& t) {
+        return (size_t)(t.Name.Hash() * 31 + t.Arguments);
+    }
+};
+
+template <>
+struct opHashCompare<opMacroSignature> {
+    static bool Compare(const opMacroSignature& t1,
+                        const opMacroSignature& t2) {
+        return t1 == t2;
+    }
+};
+
+}  // namespace opstl
+
 ///==========================================
 /// opSymbolTracker
 ///==========================================
@@ -27,9 +64,9 @@ class opSymbolTracker {
     void Register(OPMacroNode* innode);
 
     // query function
-    OPMacroNode* OPMacroRegistered(const opString& name);
+    OPMacroNode* OPMacroRegistered(const opMacroSignature& signature);
 
    private:
     // NOTE: we have a different hash table for each opcpp construct
-    opHashTable<opString, OPMacroNode*> OPMacrosTable;
+    opHashTable<opMacroSignature, OPMacroNode*> OPMacrosTable;
 };
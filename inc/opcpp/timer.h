@@ -13,6 +13,9 @@
 
 // Lucas: Special Timer Code
 
+// the platform sources include this header on its own
+#include <boost/thread/mutex.hpp>
+
 namespace timing {
 
 class opTimer {
@@ -25,4 +28,79 @@ class opTimer {
     static double invtimerfrequency;
 };
 
+///==========================================
+/// opTrace
+///==========================================
+
+// records nested spans for -trace, saved as chrome trace events
+class opTrace {
+   public:
+    static void Start();
+    static bool Save(const opString& filename);
+
+    static bool IsEnabled() { return bEnabled; }
+
+    static void Record(const opString& name, const char* category,
+                       double start, double end);
+
+   private:
+    struct Event {
+        opString Name;
+        const char* Category;
+        double Start;
+        double Duration;
+        int Thread;
+    };
+
+    static opString Escape(const opString& s);
+
+    static bool bEnabled;
+    static double StartTime;
+    static boost::mutex EventsMutex;
+    static opArray<Event> Events;
+    static int NumThreads;
+    static THREAD_LOCAL int Thread;
+};
+
+// times its scope as a trace span (does nothing without -trace)
+class opTraceScope {
+   public:
+    opTraceScope() : Category(NULL), StartTime(0) {}
+
+    opTraceScope(const char* name, const char* category)
+        : Category(NULL), StartTime(0) {
+        if (opTrace::IsEnabled()) Begin(name, category);
+    }
+
+    ~opTraceScope() { End(); }
+
+    void Begin(const opString& name, const char* category) {
+        Name = name;
+        Category = category;
+        StartTime = opTimer::GetTimeSeconds();
+    }
+
+    void End() {
+        if (!Category) return;
+
+        opTrace::Record(Name, Category, StartTime, opTimer::GetTimeSeconds());
+        Category = NULL;
+    }
+
+    // ends this span and starts the next one
+    void Next(const char* name, const char* category) {
+        End();
+
+        if (opTrace::IsEnabled()) Begin(name, category);
+    }
+
+   private:
+    opTraceScope(const opTraceScope&);
+    opTraceScope& operator=(const opTraceScope&);
+
+    opString Name;
+    const char* Category;
+    double StartTime;
+};
+
 };  // namespace timing
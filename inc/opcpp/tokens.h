@@ -674,8 +674,12 @@ class opTokenMap {
     static opString GetString(Token t) { return TokenToString[t]; }
 
     static Token GetToken(const opString& s) {
+        return GetToken(s.GetCString(), s.Length());
+    }
+
+    static Token GetToken(const char* text, int length) {
         Token t = T_UNKNOWN;
-        bool bResult = StringToToken.Find(s, t);
+        StringToToken.Find(text, length, t);
 
         return t;
     }
@@ -685,20 +689,23 @@ class opTokenMap {
         StringToToken.Insert(s, t);
     }
 
+    // called once all pairs are added (by InitTokens)
+    static bool BuildLookup() { return StringToToken.Build(); }
+
     /*=== These methods are for registering dialect modifiers only. ===*/
 
     static void AddDialectModifierPair(Token t, const opString& s) {
         TokenToDialectModifier[t] = s;
     }
 
-    static opString GetDialectModifierString(Token t) {
+    static const opString& GetDialectModifierString(Token t) {
         return TokenToDialectModifier[t];
     }
 
    private:
     static opString TokenToString[Tokens_MAX];
-    static opHashTable<opString, Token> StringToToken;
-    static opHashTable<Token, opString> TokenToDialectModifier;
+    static opPerfectHash<Token> StringToToken;
+    static opString TokenToDialectModifier[Tokens_MAX];
 };
 
 /**** opToken class ****/
@@ -706,19 +713,69 @@ class opTokenMap {
 // Initialization function for tokens.
 void InitTokens();
 
+// scanned file text, shared by the tokens and terminals that view it
+typedef std::shared_ptr<const FileBuffer> opSourceBuffer;
+
 // struct for an opToken
+// scanned tokens view their text in the scanned file, tokens the
+// scanner rewrites (or builds) own their text in Value instead
 struct opToken {
     // construction / destruction
-    opToken() : Id(Tokens_MAX), Line(0) {}
+    opToken() : Id(Tokens_MAX), Line(0), Text(NULL), Length(0) {}
+
+    opToken(Token _id, const char* _text, int _length, int _line)
+        : Id(_id), Line(_line), Text(_text), Length(_length) {}
 
     opToken(Token _id, const opString& _value, int _line)
-        : Id(_id), Value(_value), Line(_line) {}
+        : Id(_id), Line(_line), Text(NULL), Length(0), Value(_value) {}
+
+    /**** text ****/
+
+    bool IsView() const { return Text != NULL; }
+
+    int Size() const { return Text ? Length : Value.Length(); }
+
+    const char* GetText() const { return Text ? Text : Value.GetCString(); }
+
+    char Front() const { return GetText()[0]; }
+
+    char Back() const { return GetText()[Size() - 1]; }
 
-    opToken(const opToken& s) : Id(s.Id), Value(s.Value), Line(s.Line) {}
+    bool Equals(const char* s) const {
+        int length = (int)strlen(s);
+
+        return Size() == length && memcmp(GetText(), s, length) == 0;
+    }
+
+    opString GetValue() const {
+        return Text ? opString(string(Text, Length)) : Value;
+    }
+
+    void SetValue(const opString& _value) {
+        Value = _value;
+        Text = NULL;
+        Length = 0;
+        Symbol = opSymbol();
+    }
+
+    // appends the next token's text (stays a view if they're adjacent)
+    void Append(const opToken& next) {
+        if (Text && next.Text && Text + Length == next.Text) {
+            Length += next.Length;
+            Symbol = opSymbol();
+        } else
+            SetValue(GetValue() + next.GetValue());
+    }
 
     Token Id;
-    opString Value;
     int Line;
+    const char* Text;
+    int Length;
+    opString Value;
+
+    // the interned text of an identifier, once the scanner has looked it
+    // up (null otherwise, and once the text changes)
+    opSymbol Symbol;
 };
 
 //
@@ -621,7 +621,7 @@ class opIncludeWalker {
             path includepath = includestring.GetString();
 
             // Error if the file does not exist.
-            if (!exists(includepath))
+            if (!opPathCache::Exists(includepath))
                 opError::MessageError(
                     include,
                     "opinclude file '" + includestring + "' not found.");
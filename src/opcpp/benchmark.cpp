@@ -0,0 +1,89 @@
+///****************************************************************
+/// Copyright  2008 opGames LLC - All Rights Reserved
+///
+/// Authors: Kevin Depue & Lucas Ellis
+///
+/// File: Benchmark.cpp
+/// Date: 10/17/2026
+///
+/// Description:
+///
+/// Benchmark source code.
+///****************************************************************
+
+#include "opcpp/opcpp.h"
+
+namespace timing {
+
+//
+// opBenchmark
+//
+
+opBenchmark::Mode opBenchmark::CurrentMode = opBenchmark::None;
+opString opBenchmark::ModeName;
+bool opBenchmark::bCounting = false;
+double opBenchmark::StartTime = 0;
+std::atomic<long long> opBenchmark::BytesRead(0);
+std::atomic<long long> opBenchmark::Tokens(0);
+std::atomic<long long> opBenchmark::Nodes(0);
+std::atomic<long long> opBenchmark::BytesEmitted(0);
+
+bool opBenchmark::SetMode(const opString& mode) {
+    if (mode == "")
+        CurrentMode = None;
+    else if (mode == "scan")
+        CurrentMode = Scan;
+    else if (mode == "parse")
+        CurrentMode = Parse;
+    else if (mode == "emit")
+        CurrentMode = Emit;
+    else
+        return false;
+
+    ModeName = mode;
+    return true;
+}
+
+void opBenchmark::Start() {
+    BytesRead = 0;
+    Tokens = 0;
+    Nodes = 0;
+    BytesEmitted = 0;
+
+    bCounting = true;
+    StartTime = opTimer::GetTimeSeconds();
+}
+
+// per second, 0 for runs too quick to time
+static long long PerSecond(long long count, double seconds) {
+    return seconds > 0 ? (long long)(count / seconds) : 0;
+}
+
+void opBenchmark::Report(int files) {
+    double seconds = opTimer::GetTimeSeconds() - StartTime;
+
+    bCounting = false;
+
+    using std::to_string;
+
+    opString report = opString("{\"mode\":\"") + ModeName + "\"";
+
+    report += ",\"files\":" + to_string(files);
+    report += ",\"seconds\":" + to_string(seconds);
+    report += ",\"bytes_read\":" + to_string(BytesRead.load());
+    report += ",\"tokens\":" + to_string(Tokens.load());
+    report += ",\"nodes\":" + to_string(Nodes.load());
+    report += ",\"bytes_emitted\":" + to_string(BytesEmitted.load());
+    report +=
+        ",\"bytes_read_per_s\":" + to_string(PerSecond(BytesRead, seconds));
+    report += ",\"tokens_per_s\":" + to_string(PerSecond(Tokens, seconds));
+    report += ",\"nodes_per_s\":" + to_string(PerSecond(Nodes, seconds));
+    report += ",\"bytes_emitted_per_s\":" +
+              to_string(PerSecond(BytesEmitted, seconds));
+    report += ",\"peak_rss_kb\":" + to_string(opPlatform::GetPeakMemoryKb());
+    report += "}";
+
+    Log(report);
+}
+
+}  // namespace timing
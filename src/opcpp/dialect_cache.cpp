@@ -0,0 +1,829 @@
+///****************************************************************
+/// Copyright  2008 opGames LLC - All Rights Reserved
+///
+/// Authors: Kevin Depue & Lucas Ellis
+///
+/// File: DialectCache.cpp
+/// Date: 10/17/2026
+///
+/// Description:
+///
+/// Dialect cache source code.
+///****************************************************************
+
+#include "opcpp/opcpp.h"
+
+///==========================================
+/// node factories
+///==========================================
+
+namespace metaprogramming {
+
+struct CacheFactory {
+    opNode* (*Create)();
+    const char* Name;
+};
+
+// a token's node type, terminals are all TerminalNodes
+template <Token id, bool bGrammar = tokenmapping::IsGrammar<id>::value>
+struct CacheNodeType {
+    typedef TerminalNode type;
+
+    static const char* GetName() { return "TerminalNode"; }
+};
+
+template <Token id>
+struct CacheNodeType<id, true> {
+    typedef typename tokenmapping::TokenNodeType<id>::type type;
+
+    static const char* GetName() { return tokenmapping::TokenString<id>(); }
+};
+
+// abstract nodes have no factory
+template <Token id, class T, bool bAbstract = std::is_abstract<T>::value>
+struct CacheNodeCreator {
+    static void Fill(CacheFactory& factory) {}
+};
+
+template <Token id, class T>
+struct CacheNodeCreator<id, T, false> {
+    static opNode* Create() { return *NEWNODE(T); }
+
+    static void Fill(CacheFactory& factory) {
+        factory.Create = &Create;
+        factory.Name = CacheNodeType<id>::GetName();
+    }
+};
+
+// nor do grammars whose node is only declared
+template <Token id, class T = typename CacheNodeType<id>::type,
+          class = void>
+struct CacheNodeFactory {
+    static void Fill(CacheFactory& factory) {}
+};
+
+template <Token id, class T>
+struct CacheNodeFactory<id, T, decltype(void(sizeof(T)))>
+    : CacheNodeCreator<id, T> {};
+
+// fills in the factories of terminals and grammars
+template <Token current>
+struct InitializeCacheFactories {
+    static void Exec(CacheFactory* factories) {
+        if (TokenFunctions::IsTerminal(current) ||
+            tokenmapping::IsGrammar<current>::value) {
+            CacheNodeFactory<current>::Fill(factories[current]);
+        }
+
+        InitializeCacheFactories<(Token)(current + 1)>::Exec(factories);
+    }
+};
+
+// ends on Tokens_MAX
+template <>
+struct InitializeCacheFactories<Tokens_MAX> {
+    static void Exec(CacheFactory* factories) {}
+};
+
+}  // namespace metaprogramming
+
+namespace {
+
+// indexed by id, up to T_UNKNOWN
+const CacheFactory* GetCacheFactories() {
+    static CacheFactory factories[T_UNKNOWN + 1];
+    static bool bInitialized = false;
+
+    if (!bInitialized) {
+        InitializeCacheFactories<Tokens_MIN>::Exec(factories);
+
+        // the dialect scanner leaves directives as unknown terminals
+        CacheNodeFactory<T_UNKNOWN>::Fill(factories[T_UNKNOWN]);
+
+        bInitialized = true;
+    }
+
+    return factories;
+}
+
+// grammars with nothing to cache besides their children
+bool IsMemberless(Token id) {
+    switch (id) {
+        case G_CATEGORY_BODY:
+        case G_CATEGORY_LOCATION_BODY:
+        case G_ENUMERATION_BODY:
+        case G_ENUMERATION_LOCATION_BODY:
+        case G_CODE_BODY:
+        case G_FILE_DECLARATION_BODY:
+        case G_BRACE_BLOCK:
+        case G_PAREN_BLOCK:
+        case G_BRACKET_BLOCK:
+        case G_ANGLED_BLOCK:
+        case G_OPMACRO_BODY:
+        case G_OPDEFINE_BODY:
+        case G_EXPAND_CALL_ARGUMENT:
+        case G_SINGLE_QUOTE_OPERATOR:
+        case G_DOUBLE_QUOTE_OPERATOR:
+            return true;
+        default:
+            return false;
+    }
+}
+
+}  // namespace
+
+///==========================================
+/// opDialectCache
+///==========================================
+
+// build stamp, token ids and node layouts are only valid for the same
+// compiler
+opString opDialectCache::GetStamp() {
+    return opString("opdohcache 1 ") + __DATE__ + " " + __TIME__ + " " +
+           (int)Tokens_MAX;
+}
+
+FileNode* opDialectCache::Load(const opString& filename, const opString& key) {
+    if (!exists(path(filename.GetString()))) return NULL;
+
+    // terminals view the text in the buffer, the tree keeps it
+    std::shared_ptr<FileBuffer> buffer(new FileBuffer);
+
+    {
+        FileReadStream ifs(filename);
+
+        if (!ifs.IsOpen()) return NULL;
+
+        ifs.ReadToBuffer(*buffer);
+    }
+
+    if (buffer->Size() == 0) return NULL;
+
+    opDialectCache cache(true);
+    cache.Data = &(*buffer)[0];
+    cache.Size = buffer->Size();
+
+    FileNode* root = cache.ReadTree(key);
+
+    if (!root) return NULL;
+
+    root->SetSourceBuffer(buffer);
+    FileNode::FileTable.push_back(root);
+
+    return root;
+}
+
+bool opDialectCache::Save(FileNode* root, const opString& filename,
+                          const opString& key) {
+    opDialectCache cache(false);
+
+    if (cache.WriteTree(root, key)) {
+        FileWriteStream ofs(filename);
+
+        if (ofs.IsOpen()) {
+            ofs.Write(opString(cache.Out));
+            ofs.Close();
+            return true;
+        }
+    }
+
+    path cachepath = filename.GetString();
+
+    if (exists(cachepath)) remove(cachepath);
+
+    return false;
+}
+
+bool opDialectCache::WriteTree(FileNode* root, const opString& key) {
+    opString stamp = GetStamp();
+    opString cachekey = key;
+
+    String(stamp);
+    String(cachekey);
+
+    // index every node first, members may refer to later ones
+    AddNodes(root);
+
+    if (bFailed) return false;
+
+    for (size_t i = 0; i < Tree.size(); i++)
+        Indices.push_back(make_pair(Tree[i], i));
+
+    sort(Indices.begin(), Indices.end());
+
+    const CacheFactory* factories = GetCacheFactories();
+
+    Number(Tree.size());
+
+    for (size_t i = 0; i < Tree.size() && !bFailed; i++) {
+        opNode* node = Tree[i];
+        Token id = node->GetId();
+
+        // it has to be recreated from its id
+        if (id > T_UNKNOWN || !factories[id].Create ||
+            strcmp(node->GetNodeType(), factories[id].Name) != 0)
+            return false;
+
+        FileNode* file = node->GetFile();
+        FileNode* parentfile = node->GetParent()
+                                   ? node->GetParent()->GetFile()
+                                   : root;
+
+        Number(id);
+        Number((size_t)(node->GetLine() + 1));
+
+        if (file == parentfile)
+            Number(0);
+        else if (!file)
+            Number(1);
+        else
+            Number(GetIndex(file) + 1);
+
+        Number(node->NumChildren());
+
+        if (!node->CacheMembers(*this) && !IsMemberless(id)) return false;
+    }
+
+    return !bFailed;
+}
+
+void opDialectCache::AddNodes(opNode* node) {
+    Tree.push_back(node);
+
+    opNode::iterator it = node->GetBegin();
+    opNode::iterator end = node->GetEnd();
+
+    while (it != end) {
+        // a shared node would be cached twice
+        if (it->GetParent() != node) {
+            Fail();
+            return;
+        }
+
+        AddNodes(*it);
+        ++it;
+    }
+}
+
+size_t opDialectCache::GetIndex(opNode* node) {
+    if (!node) return 0;
+
+    vector<pair<opNode*, size_t> >::iterator it = lower_bound(
+        Indices.begin(), Indices.end(), make_pair(node, (size_t)0));
+
+    // members outside of the tree can't be cached
+    if (it == Indices.end() || it->first != node) {
+        Fail();
+        return 0;
+    }
+
+    return it->second + 1;
+}
+
+FileNode* opDialectCache::ReadTree(const opString& key) {
+    opString stamp;
+    opString cachekey;
+
+    String(stamp);
+    String(cachekey);
+
+    if (bFailed || stamp != GetStamp() || cachekey != key) return NULL;
+
+    size_t count = GetNumber();
+
+    if (bFailed || count == 0 || count > Size - Pos) return NULL;
+
+    // the root is allocated like a loaded file's, the rest of the tree
+    // from its arena
+    size_t children = 0;
+    opNode* first = ReadNode(NULL, children);
+    FileNode* root = first ? first->ToFileNode() : NULL;
+
+    if (!root || bFailed) {
+        delete first;
+        return NULL;
+    }
+
+    root->Arena = new opNodeArena;
+
+    {
+        opNodeArena::Scope arenascope(root->Arena);
+
+        // nodes still missing children, and how many
+        vector<pair<opNode*, size_t> > open;
+
+        if (children) open.push_back(make_pair(first, children));
+
+        for (size_t i = 1; i < count && !bFailed; i++) {
+            if (open.empty()) {
+                Fail();
+                break;
+            }
+
+            opNode* parent = open.back().first;
+
+            if (--open.back().second == 0) open.pop_back();
+
+            opNode* node = ReadNode(parent, children);
+
+            if (node && children) open.push_back(make_pair(node, children));
+        }
+
+        if (!open.empty() || Pos != Size) Fail();
+    }
+
+    for (size_t i = 0; i < Fixups.size() && !bFailed; i++) {
+        if (Fixups[i].Index >= Tree.size())
+            Fail();
+        else
+            Fixups[i].Assign(Fixups[i].Member, Tree[Fixups[i].Index]);
+    }
+
+    if (bFailed) {
+        delete root;
+        return NULL;
+    }
+
+    return root;
+}
+
+opNode* opDialectCache::ReadNode(opNode* parent, size_t& children) {
+    const CacheFactory* factories = GetCacheFactories();
+
+    size_t id = GetNumber();
+    size_t line = GetNumber();
+    size_t file = GetNumber();
+
+    children = GetNumber();
+
+    if (bFailed || id > T_UNKNOWN || !factories[id].Create ||
+        children > Size - Pos) {
+        Fail();
+        return NULL;
+    }
+
+    opNode* node = factories[id].Create();
+
+    node->SetId((Token)id);
+    node->SetLine((int)line - 1);
+
+    Tree.push_back(node);
+
+    // the root is its own file
+    if (parent) {
+        if (file == 0)
+            node->SetFile(parent->GetFile());
+        else if (file == 1)
+            node->SetFile(NULL);
+        else if (file - 2 < Tree.size() && Tree[file - 2]->ToFileNode())
+            node->SetFile(Tree[file - 2]->ToFileNode());
+        else
+            Fail();
+
+        stacked<opNode> child = stacked<opNode>::buildstacked(node);
+        parent->AppendNode(child);
+    } else if (file != 0)
+        Fail();
+
+    node->CacheMembers(*this);
+
+    return node;
+}
+
+void opDialectCache::Number(size_t n) {
+    while (n >= 0x80) {
+        Out += (char)(n | 0x80);
+        n >>= 7;
+    }
+
+    Out += (char)n;
+}
+
+size_t opDialectCache::GetNumber() {
+    size_t n = 0;
+
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (Pos >= Size) break;
+
+        unsigned char byte = (unsigned char)Data[Pos++];
+
+        n |= (size_t)(byte & 0x7f) << shift;
+
+        if (!(byte & 0x80)) return n;
+    }
+
+    Fail();
+    return 0;
+}
+
+void opDialectCache::Bool(bool& b) {
+    if (bReading)
+        b = GetNumber() != 0;
+    else
+        Number(b ? 1 : 0);
+}
+
+void opDialectCache::String(opString& s) {
+    const char* text = s.GetCString();
+    int length = s.Length();
+
+    Text(text, length);
+
+    if (bReading) s = string(text, length);
+}
+
+void opDialectCache::Strings(opSet<opString>& strings) {
+    if (!bReading) {
+        Number(strings.size());
+
+        opSet<opString>::iterator end = strings.end();
+
+        for (opSet<opString>::iterator it = strings.begin(); it != end; ++it) {
+            const char* text = it->GetCString();
+            int length = it->Length();
+
+            Text(text, length);
+        }
+
+        return;
+    }
+
+    size_t count = GetNumber();
+
+    for (size_t i = 0; i < count && !bFailed; i++) {
+        opString s;
+
+        String(s);
+        strings.Insert(s);
+    }
+}
+
+void opDialectCache::Text(const char*& text, int& length) {
+    if (!bReading) {
+        Number((size_t)length);
+        Out.append(text, length);
+        return;
+    }
+
+    size_t size = GetNumber();
+
+    if (bFailed || size > Size - Pos) {
+        Fail();
+        text = "";
+        length = 0;
+        return;
+    }
+
+    text = Data + Pos;
+    length = (int)size;
+    Pos += size;
+}
+
+///==========================================
+/// nodes
+///==========================================
+
+//
+// basic nodes
+//
+
+bool TerminalNode::CacheMembers(opDialectCache& cache) {
+    const char* cachedtext = GetText();
+    int cachedlength = length;
+
+    cache.Text(cachedtext, cachedlength);
+
+    if (cache.IsReading()) {
+        text = cachedtext;
+        length = cachedlength;
+    }
+
+    return true;
+}
+
+bool ScopeNode::CacheMembers(opDialectCache& cache) {
+    cache.Bool(bGlobal);
+    cache.Nodes(Scope);
+
+    return true;
+}
+
+bool PreprocessorNode::CacheMembers(opDialectCache& cache) {
+    cache.String(DirectiveName);
+
+    return true;
+}
+
+bool FileNode::CacheMembers(opDialectCache& cache) {
+    cache.String(InputName);
+    cache.String(AbsoluteFileName);
+    cache.Bool(bAbsolutePath);
+    cache.Strings(Dependencies);
+
+    return true;
+}
+
+bool ModifiersBase::CacheMembers(opDialectCache& cache) {
+    cache.Nodes(Modifiers);
+
+    return true;
+}
+
+//
+// dialect nodes
+//
+
+bool CategoryNode::CacheMembers(opDialectCache& cache) {
+    cache.Node(Name);
+    cache.Node(Body);
+    cache.Node(ClassPrefix);
+    cache.Node(StructPrefix);
+
+    return true;
+}
+
+bool LocationNodeBase::CacheMembers(opDialectCache& cache) {
+    cache.Node(Name);
+
+    return true;
+}
+
+bool CategoryLocationNode::CacheMembers(opDialectCache& cache) {
+    LocationNodeBase::CacheMembers(cache);
+
+    cache.Node(Body);
+
+    return true;
+}
+
+bool MapNodeBase::CacheMembers(opDialectCache& cache) {
+    cache.Node(Name);
+    cache.Node(Order);
+
+    return true;
+}
+
+// the map info is set when registering
+bool CategoryMapNode::CacheMembers(opDialectCache& cache) {
+    MapNodeBase::CacheMembers(cache);
+
+    cache.Node(Body);
+
+    return true;
+}
+
+// the expression map is set when registering
+bool CategoryExpressionMapNode::CacheMembers(opDialectCache& cache) {
+    return true;
+}
+
+bool DisallowNode::CacheMembers(opDialectCache& cache) {
+    cache.Node(Name);
+    cache.Node(Body);
+
+    return true;
+}
+
+bool ModifierArgumentNode::CacheMembers(opDialectCache& cache) {
+    cache.Node(Condition);
+
+    return true;
+}
+
+bool ModifierNodeBase::CacheMembers(opDialectCache& cache) {
+    cache.Node(Name);
+    cache.Node(Arguments);
+
+    return true;
+}
+
+bool CriteriaArgumentNode::CacheMembers(opDialectCache& cache) {
+    cache.Node(Argument);
+
+    return true;
+}
+
+bool IsNode::CacheMembers(opDialectCache& cache) {
+    cache.Node(Body);
+
+    return true;
+}
+
+bool CriteriaValueModifierNode::CacheMembers(opDialectCache& cache) {
+    cache.Node(Name);
+    cache.Node(Argument);
+
+    return true;
+}
+
+bool CriteriaBodyNode::CacheMembers(opDialectCache& cache) {
+    cache.Nodes(Operands);
+    cache.Values(Operators);
+    cache.Bool(bNegate);
+
+    return true;
+}
+
+bool NoteNode::CacheMembers(opDialectCache& cache) {
+    cache.Node(Name);
+    cache.Node(Body);
+    cache.Node(Order);
+
+    return true;
+}
+
+bool NoteArgumentNode::CacheMembers(opDialectCache& cache) {
+    cache.Node(Name);
+
+    return true;
+}
+
+bool NoteArgumentListNode::CacheMembers(opDialectCache& cache) {
+    cache.Nodes(Arguments);
+
+    return true;
+}
+
+bool NoteDefinitionNode::CacheMembers(opDialectCache& cache) {
+    cache.Node(Path);
+    cache.Node(Arguments);
+    cache.Node(Body);
+    cache.Node(Override);
+    cache.Bool(bVerbatim);
+
+    return true;
+}
+
+bool EnumerationNode::CacheMembers(opDialectCache& cache) {
+    cache.Node(Name);
+    cache.Node(Body);
+    cache.Node(EnumPrefix);
+
+    return true;
+}
+
+bool EnumerationLocationNode::CacheMembers(opDialectCache& cache) {
+    LocationNodeBase::CacheMembers(cache);
+
+    cache.Node(Body);
+
+    return true;
+}
+
+bool CodeNode::CacheMembers(opDialectCache& cache) {
+    cache.Node(Name);
+    cache.Node(Body);
+    cache.Bool(bVerbatim);
+
+    return true;
+}
+
+bool ExtendPointNode::CacheMembers(opDialectCache& cache) {
+    cache.Node(Name);
+    cache.Node(Body);
+
+    return true;
+}
+
+bool ExtensionNode::CacheMembers(opDialectCache& cache) {
+    cache.Node(Name);
+    cache.Nodes(ExtendPoints);
+
+    return true;
+}
+
+bool ExtensionPointNode::CacheMembers(opDialectCache& cache) {
+    cache.Node(Name);
+
+    return true;
+}
+
+bool FileDeclarationLocationNode::CacheMembers(opDialectCache& cache) {
+    cache.Node(Name);
+    cache.Node(Order);
+
+    return true;
+}
+
+bool FileDeclarationNode::CacheMembers(opDialectCache& cache) {
+    cache.Node(Name);
+    cache.Node(Body);
+
+    return true;
+}
+
+bool DialectNamespaceNode::CacheMembers(opDialectCache& cache) {
+    cache.Node(Name);
+    cache.Node(Body);
+
+    return true;
+}
+
+//
+// dialect modifier and statement nodes
+//
+
+// the modifier name is set by Init
+bool DialectModifierNode::CacheMembers(opDialectCache& cache) {
+    return true;
+}
+
+bool ValuedDialectModiferNode::CacheMembers(opDialectCache& cache) {
+    cache.Node(Value);
+
+    return true;
+}
+
+bool OrderModifierNodeBase::CacheMembers(opDialectCache& cache) {
+    ValuedDialectModiferNode::CacheMembers(cache);
+
+    cache.Node(Location);
+
+    return true;
+}
+
+bool PrefixNodeBase::CacheMembers(opDialectCache& cache) {
+    ValuedDialectModiferNode::CacheMembers(cache);
+
+    cache.Node(Prefix);
+
+    return true;
+}
+
+bool DialectStatementBase::CacheMembers(opDialectCache& cache) {
+    cache.Node(Modifiers);
+    cache.Node(Statement);
+
+    return true;
+}
+
+//
+// extension and macro nodes
+//
+
+bool OPDefineNode::CacheMembers(opDialectCache& cache) {
+    cache.Node(Name);
+    cache.Node(Arguments);
+    cache.Node(Body);
+
+    return true;
+}
+
+bool OPIncludeNode::CacheMembers(opDialectCache& cache) {
+    cache.Node(FileName);
+    cache.Node(IncludedFile);
+
+    return true;
+}
+
+bool OPMacroArgumentNode::CacheMembers(opDialectCache& cache) {
+    cache.Node(VariableName);
+
+    return true;
+}
+
+bool OPMacroArgumentListNode::CacheMembers(opDialectCache& cache) {
+    cache.Nodes(Arguments);
+
+    return true;
+}
+
+bool OPMacroNode::CacheMembers(opDialectCache& cache) {
+    cache.Node(Name);
+    cache.Node(Arguments);
+    cache.Node(Body);
+
+    return true;
+}
+
+bool ExpandCallArgumentListNode::CacheMembers(opDialectCache& cache) {
+    cache.Nodes(Arguments);
+
+    return true;
+}
+
+bool ExpandCallNode::CacheMembers(opDialectCache& cache) {
+    cache.Node(Name);
+    cache.Node(Arguments);
+
+    return true;
+}
+
+bool ExpandableArgumentNode::CacheMembers(opDialectCache& cache) {
+    cache.String(value);
+
+    return true;
+}
+
+bool ConcatenationArgumentOperatorNode::CacheMembers(opDialectCache& cache) {
+    cache.Node(Argument);
+
+    return true;
+}
+
+bool ConcatenationOperatorNode::CacheMembers(opDialectCache& cache) {
+    cache.Node(Left);
+    cache.Node(Right);
+
+    return true;
+}
@@ -608,7 +608,7 @@ bool CriteriaBodyNode::Evaluate(ModifierSupportBase* statement) {
 bool CriteriaBodyNode::EvaluateOperand(opNode* operand,
                                        ModifierSupportBase* statement) {
     if (TerminalNode* modifier = node_cast<TerminalNode>(operand)) {
-        return statement->HasModifier(modifier->GetValue());
+        return statement->HasModifier(modifier->GetSymbol());
     } else if (CriteriaValueModifierNode* valuemod =
                    node_cast<CriteriaValueModifierNode>(operand)) {
         const opString& name = valuemod->GetName()->GetValue();
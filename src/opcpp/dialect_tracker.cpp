@@ -18,18 +18,36 @@
 ///
 
 DialectTracker DialectTracker::Instance;
+THREAD_LOCAL opSet<opString>* DialectTracker::Consumer = NULL;
 
 DialectTracker::DialectTracker() {}
 
-DialectTracker::~DialectTracker() {
+DialectTracker::~DialectTracker() { Clear(); }
+
+void DialectTracker::Reset() { GetInstance().Clear(); }
+
+void DialectTracker::Clear() {
     // delete all categories
     CategoryNodes.DeleteAllValues();
+    CategoryNodes.Clear();
 
     // delete all enumerations
     EnumerationNodes.DeleteAllValues();
+    EnumerationNodes.Clear();
 
     // delete all file declarations
     FileDeclarationNodes.DeleteAllValues();
+    FileDeclarationNodes.Clear();
+
+    GlobalNodes.Clear();
+    ExtensionNodes.Clear();
+    FileDeclarationLocations.Clear();
+    AltClassMap.Clear();
+    AltStructMap.Clear();
+    AltEnumMap.Clear();
+    Prefixes.Clear();
+    Fingerprints.Clear();
+    EntityFiles.Clear();
 }
 
 DialectCategory::DialectCategory(const opString& name, CategoryNode* node)
@@ -113,7 +131,8 @@ opNode* DialectEnumeration::GetTypeNode() { return Node; }
 // register a category
 DialectCategory* DialectTracker::RegisterCategory(CategoryNode* node) {
     opString name = node->GetName()->GetValue();
-    categoryiterator it = CategoryNodes.Find(name);
+    opSymbol symbol = node->GetName()->GetSymbol();
+    categoryiterator it = CategoryNodes.Find(symbol);
     categoryiterator end = CategoryNodes.End();
 
     /*=== If the category is not yet registered, register it. ===*/
@@ -121,15 +140,18 @@ DialectCategory* DialectTracker::RegisterCategory(CategoryNode* node) {
     if (it == end) {
         RegisterGlobal(name, node);
 
-        it = CategoryNodes.Insert(name, new DialectCategory(name, node));
+        it = CategoryNodes.Insert(symbol, new DialectCategory(name, node));
     }
 
+    AddFingerprint("category:" + name, node);
+
     /*=== Check for alt prefixes. ===*/
 
     {
         // Check if we have a class prefix.
         if (ClassPrefixNode* prefix = node->GetClassPrefix()) {
             opString prefixstring = prefix->GetPrefix()->GetValue();
+            opSymbol prefixsymbol = prefix->GetPrefix()->GetSymbol();
             CategoryNode* old;
             opString name;
 
@@ -140,7 +162,7 @@ DialectCategory* DialectTracker::RegisterCategory(CategoryNode* node) {
                                                     prefix);
             }
             // If this class prefix already exists, throw an error.
-            else if (AltClassMap.Find(prefixstring, old)) {
+            else if (AltClassMap.Find(prefixsymbol, old)) {
                 ClassPrefixNode* oldprefix = old->GetClassPrefix();
 
                 prefix->PrintString(name);
@@ -151,7 +173,7 @@ DialectCategory* DialectTracker::RegisterCategory(CategoryNode* node) {
             else {
                 RegisterGlobal(prefixstring, prefix);
 
-                AltClassMap[prefixstring] = node;
+                AltClassMap.Insert(prefixsymbol, node);
 
                 (*it).second->SetPrefix(prefix);
 
@@ -161,6 +183,7 @@ DialectCategory* DialectTracker::RegisterCategory(CategoryNode* node) {
         // Check if we have a struct prefix.
         else if (StructPrefixNode* prefix = node->GetStructPrefix()) {
             opString prefixstring = prefix->GetPrefix()->GetValue();
+            opSymbol prefixsymbol = prefix->GetPrefix()->GetSymbol();
             CategoryNode* old;
             opString name;
 
@@ -171,7 +194,7 @@ DialectCategory* DialectTracker::RegisterCategory(CategoryNode* node) {
                                                     prefix);
             }
             // If this class prefix already exists, throw an error.
-            else if (AltStructMap.Find(prefixstring, old)) {
+            else if (AltStructMap.Find(prefixsymbol, old)) {
                 StructPrefixNode* oldprefix = old->GetStructPrefix();
 
                 prefix->PrintString(name);
@@ -182,7 +205,7 @@ DialectCategory* DialectTracker::RegisterCategory(CategoryNode* node) {
             else {
                 RegisterGlobal(prefixstring, prefix);
 
-                AltStructMap[prefixstring] = node;
+                AltStructMap.Insert(prefixsymbol, node);
 
                 (*it).second->SetPrefix(prefix);
 
@@ -197,7 +220,8 @@ DialectCategory* DialectTracker::RegisterCategory(CategoryNode* node) {
 // register an enumeration
 DialectEnumeration* DialectTracker::RegisterEnumeration(EnumerationNode* node) {
     opString name = node->GetName()->GetValue();
-    enumerationiterator it = EnumerationNodes.Find(name);
+    opSymbol symbol = node->GetName()->GetSymbol();
+    enumerationiterator it = EnumerationNodes.Find(symbol);
     enumerationiterator end = EnumerationNodes.End();
 
     /*=== If the enumeration is not yet registered, register it. ===*/
@@ -205,15 +229,19 @@ DialectEnumeration* DialectTracker::RegisterEnumeration(EnumerationNode* node) {
     if (it == end) {
         RegisterGlobal(name, node);
 
-        it = EnumerationNodes.Insert(name, new DialectEnumeration(name, node));
+        it = EnumerationNodes.Insert(symbol,
+                                     new DialectEnumeration(name, node));
     }
 
+    AddFingerprint("enumeration:" + name, node);
+
     /*=== Check for alt prefixes. ===*/
 
     {
         // Check if we have an enumeration prefix.
         if (EnumPrefixNode* prefix = node->GetEnumPrefix()) {
             opString prefixstring = prefix->GetPrefix()->GetValue();
+            opSymbol prefixsymbol = prefix->GetPrefix()->GetSymbol();
             EnumerationNode* old;
             opString name;
 
@@ -224,7 +252,7 @@ DialectEnumeration* DialectTracker::RegisterEnumeration(EnumerationNode* node) {
                                                     prefix);
             }
             // If this class prefix already exists, throw an error.
-            else if (AltEnumMap.Find(prefixstring, old)) {
+            else if (AltEnumMap.Find(prefixsymbol, old)) {
                 EnumPrefixNode* oldprefix = old->GetEnumPrefix();
 
                 prefix->PrintString(name);
@@ -235,7 +263,7 @@ DialectEnumeration* DialectTracker::RegisterEnumeration(EnumerationNode* node) {
             else {
                 RegisterGlobal(prefixstring, prefix);
 
-                AltEnumMap[prefixstring] = node;
+                AltEnumMap.Insert(prefixsymbol, node);
 
                 (*it).second->SetPrefix(prefix);
 
@@ -258,6 +286,8 @@ void DialectTracker::RegisterExtension(ExtensionNode* node) {
     }
 
     ExtensionNodes.Insert(name, node);
+
+    AddFingerprint("extension:" + name, node);
 }
 
 // register an extension point
@@ -280,24 +310,44 @@ void DialectTracker::RegisterExtendPoint(ExtendPointNode* node) {
     }
 
     existing->AddExtendPoint(node);
+
+    AddFingerprint("extension:" + name, node);
 }
 
 // get a category
 DialectCategory* DialectTracker::GetCategory(const opString& name) {
+    return GetCategory(opSymbol::Intern(name));
+}
+
+DialectCategory* DialectTracker::GetCategory(const opSymbol& name) {
     categoryiterator it = GetInstance().CategoryNodes.Find(name);
     categoryiterator end = GetInstance().CategoryNodes.End();
 
-    if (it == end) return NULL;
+    if (it == end) {
+        Consume("names");
+        return NULL;
+    }
+
+    if (Consumer) Consume("category:" + name.GetString());
 
     return (*it).second;
 }
 
 // get an enumeration
 DialectEnumeration* DialectTracker::GetEnumeration(const opString& name) {
+    return GetEnumeration(opSymbol::Intern(name));
+}
+
+DialectEnumeration* DialectTracker::GetEnumeration(const opSymbol& name) {
     enumerationiterator it = GetInstance().EnumerationNodes.Find(name);
     enumerationiterator end = GetInstance().EnumerationNodes.End();
 
-    if (it == end) return NULL;
+    if (it == end) {
+        Consume("names");
+        return NULL;
+    }
+
+    if (Consumer) Consume("enumeration:" + name.GetString());
 
     return (*it).second;
 }
@@ -306,7 +356,10 @@ DialectEnumeration* DialectTracker::GetEnumeration(const opString& name) {
 ExtensionNode* DialectTracker::GetExtension(const opString& name) {
     ExtensionNode* node = NULL;
 
-    GetInstance().ExtensionNodes.Find(name, node);
+    if (!GetInstance().ExtensionNodes.Find(name, node))
+        Consume("extensions");
+    else if (Consumer)
+        Consume("extension:" + name);
 
     return node;
 }
@@ -337,12 +390,13 @@ bool DialectTracker::Register(const opString& name, opNode* node) {
 // NOTE: It only makes sense to call this function on category, enumeration,
 //       prefix, datamodifier and functionmodifier nodes!
 bool DialectTracker::RegisterGlobal(const opString& name, opNode* node) {
-    globaliterator it = GlobalNodes.Find(name);
+    opSymbol symbol = opSymbol::Intern(name);
+    globaliterator it = GlobalNodes.Find(symbol);
     globaliterator end = GlobalNodes.End();
 
     // add it, return true
     if (it == end) {
-        GlobalNodes.Insert(name, node);
+        GlobalNodes.Insert(symbol, node);
 
         return true;
     }
@@ -593,6 +647,10 @@ void DialectTracker::RegisterNote(NoteDefinitionNode* notenode) {
     // CASE 2: category/enumeration/etc.
     else if (DialectTypeBase* notetype = GetType(specifier)) {
         notetype->RegisterNote(notenode);
+
+        AddFingerprint(notetype->ToCategory() ? "category:" + specifier
+                                              : "enumeration:" + specifier,
+                       notenode);
     } else
         opError::MessageError(notenode, "Note definition specifier '" +
                                             specifier + "' is invalid.");
@@ -2023,6 +2081,8 @@ void DialectCategory::GetValueFunctionModifiers(opArray<opString>& modifiers) {
 
 // get the list of extensions
 const opMap<opString, ExtensionNode*>& DialectTracker::GetExtensions() {
+    Consume("extensions");
+
     return GetInstance().ExtensionNodes;
 }
 
@@ -2239,9 +2299,11 @@ void DialectFileDeclaration::RegisterNote(NoteDefinitionNode* notenode) {
 
 // If the class prefix exists, returns the associated CategoryNode, otherwise
 // NULL.
-CategoryNode* DialectTracker::GetAltClassPrefix(const opString& prefix) {
+CategoryNode* DialectTracker::GetAltClassPrefix(const opSymbol& prefix) {
     CategoryNode* node;
 
+    Consume("names");
+
     if (DialectTracker::GetInstance().AltClassMap.Find(prefix, node))
         return node;
 
@@ -2250,9 +2312,11 @@ CategoryNode* DialectTracker::GetAltClassPrefix(const opString& prefix) {
 
 // If the struct prefix exists, returns the associated CategoryNode, otherwise
 // NULL.
-CategoryNode* DialectTracker::GetAltStructPrefix(const opString& prefix) {
+CategoryNode* DialectTracker::GetAltStructPrefix(const opSymbol& prefix) {
     CategoryNode* node;
 
+    Consume("names");
+
     if (DialectTracker::GetInstance().AltStructMap.Find(prefix, node))
         return node;
 
@@ -2262,9 +2326,11 @@ CategoryNode* DialectTracker::GetAltStructPrefix(const opString& prefix) {
 // If the enumeration prefix exists, returns the associated EnumerationNode,
 // otherwise NULL.
 EnumerationNode* DialectTracker::GetAltEnumerationPrefix(
-    const opString& prefix) {
+    const opSymbol& prefix) {
     EnumerationNode* node;
 
+    Consume("names");
+
     if (DialectTracker::GetInstance().AltEnumMap.Find(prefix, node))
         return node;
 
@@ -2273,5 +2339,136 @@ EnumerationNode* DialectTracker::GetAltEnumerationPrefix(
 
 // This method returns all registered prefixes (a set of strings).
 const opSet<opString>& DialectTracker::GetAllPrefixes() {
+    Consume("names");
+
     return DialectTracker::GetInstance().Prefixes;
 }
+
+//
+// Dependency tracking
+//
+
+// mixes a definition's tokens (and where they are) into an entity
+void DialectTracker::AddFingerprint(const opString& entity, opNode* node) {
+    opMap<opString, hashtype>::iterator it = Fingerprints.Find(entity);
+    hashtype hash = it == Fingerprints.End() ? opBuildManifest::Hash(NULL, 0)
+                                             : it->second;
+
+    if (FileNode* file = node->GetFile()) {
+        const opString& name = file->GetInputName();
+        hash = opBuildManifest::Hash(name.GetCString(), name.Length(), hash);
+
+        EntityFiles[entity].Insert(name);
+    }
+
+    Fingerprints[entity] = HashNode(node, hash);
+}
+
+DialectTracker::hashtype DialectTracker::HashNode(opNode* node,
+                                                  hashtype hash) {
+    if (node->IsTerminal()) {
+        const opString& value = ((TerminalNode*)node)->GetValue();
+        int line = node->GetLine();
+
+        hash = opBuildManifest::Hash((const char*)&line, sizeof(line), hash);
+
+        return opBuildManifest::Hash(value.GetCString(), value.Length() + 1,
+                                       hash);
+    }
+
+    opNode::iterator i = node->GetBegin();
+    opNode::iterator end = node->GetEnd();
+
+    while (i != end) {
+        hash = HashNode(*i, hash);
+        ++i;
+    }
+
+    return hash;
+}
+
+opString DialectTracker::GetFingerprint(const opString& entity) {
+    DialectTracker& tracker = GetInstance();
+    hashtype hash = opBuildManifest::Hash(NULL, 0);
+
+    // every type and prefix name (affects how any file scans)
+    if (entity == "names") {
+        opSet<opString> names;
+
+        for (categoryiterator it = tracker.CategoryNodes.Begin();
+             it != tracker.CategoryNodes.End(); ++it)
+            names.Insert("category:" + it->first.GetString());
+
+        for (enumerationiterator it = tracker.EnumerationNodes.Begin();
+             it != tracker.EnumerationNodes.End(); ++it)
+            names.Insert("enumeration:" + it->first.GetString());
+
+        typedef opHashTable<opSymbol, CategoryNode*>::iterator prefixiterator;
+
+        for (prefixiterator it = tracker.AltClassMap.Begin();
+             it != tracker.AltClassMap.End(); ++it)
+            names.Insert("class:" + it->first.GetString() + "=" +
+                         it->second->GetName()->GetValue());
+
+        for (prefixiterator it = tracker.AltStructMap.Begin();
+             it != tracker.AltStructMap.End(); ++it)
+            names.Insert("struct:" + it->first.GetString() + "=" +
+                         it->second->GetName()->GetValue());
+
+        typedef opHashTable<opSymbol, EnumerationNode*>::iterator
+            enumprefixiterator;
+
+        for (enumprefixiterator it = tracker.AltEnumMap.Begin();
+             it != tracker.AltEnumMap.End(); ++it)
+            names.Insert("enum:" + it->first.GetString() + "=" +
+                         it->second->GetName()->GetValue());
+
+        for (opSet<opString>::iterator it = names.Begin(); it != names.End();
+             ++it)
+            hash = opBuildManifest::Hash(it->GetCString(), it->Length() + 1,
+                                           hash);
+    }
+    // every extension
+    else if (entity == "extensions") {
+        typedef opMap<opString, hashtype>::iterator fingerprintiterator;
+
+        for (fingerprintiterator it = tracker.Fingerprints.Begin();
+             it != tracker.Fingerprints.End(); ++it) {
+            if (!it->first.StartsWith("extension:")) continue;
+
+            hash = opBuildManifest::Hash(it->first.GetCString(),
+                                           it->first.Length() + 1, hash);
+            hash = opBuildManifest::Hash((const char*)&it->second,
+                                           sizeof(hashtype), hash);
+        }
+    }
+    // a single definition
+    else if (!tracker.Fingerprints.Find(entity, hash))
+        return "none";
+
+    char buffer[32];
+    sprintf(buffer, "%016llx", hash);
+
+    return buffer;
+}
+
+void DialectTracker::GetEntityFiles(const opString& entity,
+                                    opSet<opString>& files) {
+    DialectTracker& tracker = GetInstance();
+
+    typedef opMap<opString, opSet<opString> >::iterator fileiterator;
+
+    for (fileiterator it = tracker.EntityFiles.Begin();
+         it != tracker.EntityFiles.End(); ++it) {
+        // the combined entities cover every type or extension
+        bool bMatch = it->first == entity;
+
+        if (entity == "names")
+            bMatch = it->first.StartsWith("category:") ||
+                     it->first.StartsWith("enumeration:");
+        else if (entity == "extensions")
+            bMatch = it->first.StartsWith("extension:");
+
+        if (bMatch) files.Insert(it->second.Begin(), it->second.End());
+    }
+}
@@ -13,17 +13,63 @@
 
 #include "opcpp/opcpp.h"
 
+//
+// opJobQueue
+//
+
+opJobQueue::opJobQueue(const opSet<path>& files) : NextJob(0) {
+    typedef opSet<path>::const_iterator fileit;
+
+    for (fileit it = files.begin(); it != files.end(); ++it) {
+        opCompileJob job;
+        job.File = *it;
+        Jobs.PushBack(job);
+    }
+}
+
+int opJobQueue::Next() {
+    boost::mutex::scoped_lock lock(Mutex);
+
+    if (NextJob >= Jobs.Size()) return -1;
+
+    return NextJob++;
+}
+
+void opJobQueue::Finish(int index) {
+    boost::mutex::scoped_lock lock(Mutex);
+
+    Jobs[index].bDone = true;
+    Finished.notify_all();
+}
+
+opCompileJob& opJobQueue::Wait(int index) {
+    boost::mutex::scoped_lock lock(Mutex);
+
+    while (!Jobs[index].bDone) Finished.wait(lock);
+
+    return Jobs[index];
+}
+
+void opJobQueue::Cancel() {
+    boost::mutex::scoped_lock lock(Mutex);
+
+    NextJob = Jobs.Size();
+}
+
 //
 // opDriver
 //
 
 opSet<path> opDriver::OhFiles;
 opSet<path> opDriver::DohFiles;
-int opDriver::NumErrors = 0;
+opSet<opString> opDriver::DialectInputs;
+opString opDriver::DialectState;
+THREAD_LOCAL int opDriver::NumErrors = 0;
 
 void opDriver::Initialize() {
     // initialize token stuff
     InitTokens();
+    opScanner::InitWords();
 
     // init error stuff
     opError::InitParseErrors();
@@ -32,12 +78,47 @@ void opDriver::Initialize() {
     opTimer::InitTimeSeconds();
 }
 
+// saves the build manifest however conversion ends
+struct ManifestSaver {
+    ~ManifestSaver() {
+        opTraceScope trace("SaveManifest", "io");
+        opBuildManifest::Save();
+    }
+};
+
+// saves the -trace file however conversion ends
+struct TraceSaver {
+    TraceSaver(const opParameters& p) : filename(p.Trace.GetValue()) {
+        if (filename.Length()) opTrace::Start();
+    }
+
+    ~TraceSaver() {
+        if (filename.Length() && !opTrace::Save(filename))
+            Log("Could not open trace file '" + filename + "'!");
+    }
+
+    opString filename;
+};
+
 // converts the input opCPP format to c++ format
 bool opDriver::Convert(const opParameters& p) {
     opMemoryTracker memorytracker;
+    TraceSaver tracesaver(p);
+    ManifestSaver manifestsaver;
+    opTraceScope trace("Convert", "driver");
 
     bool bResult = true;
 
+    // a compile server converts many times
+    OhFiles.clear();
+    DohFiles.clear();
+    DialectInputs.Clear();
+    NumErrors = 0;
+
+    // files may have changed since the last conversion
+    opPathCache::Reset();
+    opScanner::ClearScanned();
+
     // run it
     try {
         // Validate the files specified on the command
@@ -58,7 +139,12 @@ bool opDriver::Convert(const opParameters& p) {
 
         // must be in normal mode to read dialects
         if (p.NormalMode) {
+            // content hashes of the inputs of everything generated
+            opBuildManifest::Load(GetOutputPath(p, "Generated.manifest"),
+                                  GetManifestOptions(p));
+
             // check dependencies
+            opTraceScope checktrace("CheckDependencies", "driver");
             bool bNewDependency = CheckDependencies();
 
             if (bNewDependency) {
@@ -83,7 +169,13 @@ bool opDriver::Convert(const opParameters& p) {
                 }
             }
 
-            if (!bSkipCompiling) bResult = DialectMode(p) ? bResult : false;
+            checktrace.End();
+
+            if (!bSkipCompiling) {
+                if (!ResidentDialectsCurrent(p)) ReleaseResidentDialects();
+
+                bResult = DialectMode(p) ? bResult : false;
+            }
         }
 
         if (!bSkipCompiling) {
@@ -92,10 +184,15 @@ bool opDriver::Convert(const opParameters& p) {
             // validate dialect read parameters
             if (!opParameters::ValidateParameters()) return false;
 
-            // validate registered dialects
-            if (!DialectTracker::Validate()) {
-                opError::Print();
-                return false;
+            // validate registered dialects (once for resident dialects)
+            if (!bResidentValidated) {
+                if (!DialectTracker::Validate()) {
+                    opError::Print();
+                    ReleaseResidentDialects();
+                    return false;
+                }
+
+                bResidentValidated = bResidentDialects;
             }
 
             if (p.NormalMode) bResult = NormalMode(p) ? bResult : false;
@@ -108,6 +205,8 @@ bool opDriver::Convert(const opParameters& p) {
 
         if (!bResult) return false;
 
+        if (p.Verbose) opPathCache::LogCounters();
+
         return true;
     } catch (opException::opCPP_Exception&) {
         opError::ExceptionError("opCPP");
@@ -129,9 +228,75 @@ bool opDriver::Convert(const opParameters& p) {
 
     opException::CaughtException();
 
+    // the dialect state can't be trusted after an exception
+    ReleaseResidentDialects();
+
     return false;
 }
 
+void opDriver::SetResidentDialects(bool bresident) {
+    ReleaseResidentDialects();
+    bResidentDialects = bresident;
+}
+
+// identifies what the resident dialects were read with
+opString opDriver::GetResidentKey(const opParameters& p) {
+    opString key = current_path().string();
+
+    typedef opSet<path>::const_iterator fileit;
+
+    for (fileit it = DohFiles.begin(); it != DohFiles.end(); ++it)
+        key += opString(";") + it->string();
+
+    key += "|";
+
+    for (int i = 0; i < p.Directories.size(); i++)
+        key += opString(";") + p.Directories[i];
+
+    return key;
+}
+
+// are the resident dialects usable for this conversion?
+bool opDriver::ResidentDialectsCurrent(const opParameters& p) {
+    if (!bResidentDialects || ResidentFiles.IsEmpty()) return false;
+
+    if (ResidentKey != GetResidentKey(p)) return false;
+
+    typedef opMap<opString, DialectFileNode*>::iterator residentit;
+
+    for (residentit it = ResidentFiles.begin(); it != ResidentFiles.end();
+         ++it) {
+        path dohpath = it->first.GetString();
+
+        // changes within the second we read it count too
+        if (!opPathCache::Exists(dohpath) ||
+            opPathCache::LastWriteTime(dohpath) >= ResidentTime)
+            return false;
+
+        if (it->second->IsDependencyNewer(ResidentTime - 1)) return false;
+    }
+
+    return true;
+}
+
+// forgets the resident dialects, their files are deleted with
+// the rest of the loaded files
+void opDriver::ReleaseResidentDialects() {
+    if (!bResidentDialects) return;
+
+    typedef opMap<opString, DialectFileNode*>::iterator residentit;
+
+    for (residentit it = ResidentFiles.begin(); it != ResidentFiles.end();
+         ++it)
+        it->second->SetResident(false);
+
+    ResidentFiles.Clear();
+    ResidentKey = "";
+    bResidentValidated = false;
+
+    DialectTracker::Reset();
+}
+
 void opDriver::ForceCompile() {
     opParameters& p = opParameters::GetWritable();
     p.Force = true;
@@ -158,27 +323,14 @@ bool opDriver::CheckDependencies() {
             path targetpath =
                 p.GeneratedDirectory.GetString() / targetfile.GetString();
 
-            // if it doesn't exist we need to create it
-            if (!exists(targetpath)) {
-                create_directories(p.GeneratedDirectory.GetString());
+            // compare against the contents seen last time
+            if (opBuildManifest::Check(targetpath.string()) !=
+                opBuildManifest::Current) {
+                opSet<opString> inputs;
+                inputs.Insert(filestring);
 
-                // just create a new empty target file
-                boost::filesystem::ofstream target(targetpath);
-                target << "target file used for opC++ -dependencies";
+                opBuildManifest::Record(targetpath.string(), inputs);
                 bResult = true;
-                continue;
-            }
-
-            // now check for the time
-            time_t filetime = last_write_time(filepath);
-            time_t targettime = last_write_time(targetpath);
-
-            if (filetime > targettime) {
-                // just create a new empty target file
-                boost::filesystem::ofstream target(targetpath);
-                target << "target file used for opC++ -dependencies";
-                bResult = true;
-                continue;
             }
         }
     }
@@ -218,7 +370,7 @@ bool opDriver::ValidateFiles(const opParameters& p) {
     while (i != end) {
         path filepath = (*i).GetString();
 
-        if (exists(filepath)) {
+        if (opPathCache::Exists(filepath)) {
             filepath = to_relative_path(filepath);
             OhFiles.insert(filepath);
             old = i;
@@ -242,7 +394,7 @@ bool opDriver::ValidateFiles(const opParameters& p) {
             path filepath =
                 Dirs[d].GetString() / to_relative_path((*i).GetString());
 
-            if (exists(filepath)) {
+            if (opPathCache::Exists(filepath)) {
                 filepath = to_relative_path(filepath);
                 OhFiles.insert(filepath);
                 old = i;
@@ -293,6 +445,8 @@ bool opDriver::FileExists(path file) {
 
 // compiles all files
 bool opDriver::NormalMode(const opParameters& p) {
+    opTraceScope trace("NormalMode", "driver");
+
     // verify the output directory...
     path dirpath = p.GeneratedDirectory.GetString();
 
@@ -315,10 +469,28 @@ bool opDriver::NormalMode(const opParameters& p) {
     if (p.Verbose)  // spacing in verbose mode
         Log(' ');
 
-    for (fileit it = files.begin(); it != files.end(); ++it) {
-        bResult = NormalModeFile(p, *it) ? bResult : false;
+    // code files record the dialects they were compiled against
+    DialectState = GetDialectState(p);
+
+    int numjobs = p.Jobs.GetValue();
+
+    if (numjobs == 0) numjobs = boost::thread::hardware_concurrency();
+
+    if (numjobs > (int)files.size()) numjobs = (int)files.size();
+
+    if (opBenchmark::GetMode() != opBenchmark::None) opBenchmark::Start();
+
+    if (numjobs > 1) {
+        bResult = NormalModeJobs(p, files, numjobs);
+    } else {
+        for (fileit it = files.begin(); it != files.end(); ++it) {
+            bResult = NormalModeFile(p, *it) ? bResult : false;
+        }
     }
 
+    if (opBenchmark::GetMode() != opBenchmark::None)
+        opBenchmark::Report((int)files.size());
+
     // If we had errors, print out the number of errors.
     if (NumErrors > 0) {
         Log("");
@@ -350,6 +522,83 @@ bool opDriver::NormalMode(const opParameters& p) {
     return bResult;
 }
 
+// compiles files in parallel, output and errors are
+// collected in file order so they match a serial compile
+bool opDriver::NormalModeJobs(const opParameters& p, const opSet<path>& files,
+                              int numjobs) {
+    opJobQueue queue(files);
+    boost::thread_group workers;
+
+    for (int i = 0; i < numjobs; i++)
+        workers.create_thread(
+            boost::bind(&opDriver::NormalModeWorker, this, &p, &queue));
+
+    bool bResult = true;
+    std::exception_ptr exception;
+
+    for (int i = 0; i < queue.Size(); i++) {
+        opCompileJob& job = queue.Wait(i);
+
+        for (int line = 0; line < job.Output.Size(); line++)
+            Log(job.Output[line]);
+
+        // a serial compile would have stopped here
+        if (job.Exception) {
+            exception = job.Exception;
+            break;
+        }
+
+        NumErrors += job.NumErrors;
+        bResult = job.bResult ? bResult : false;
+    }
+
+    workers.join_all();
+
+    if (exception) std::rethrow_exception(exception);
+
+    return bResult;
+}
+
+void opDriver::NormalModeWorker(const opParameters* p, opJobQueue* queue) {
+    // each worker reads (and toggles) its own parameters
+    opParameters params(*p);
+    opParameters::SetJobInstance(&params);
+
+    if (params.NoDebug) opStringStream::SetLineDirectives(false);
+
+    int index;
+
+    while ((index = queue->Next()) != -1) {
+        opCompileJob& job = queue->GetJob(index);
+
+        opTraceScope trace;
+        if (opTrace::IsEnabled()) trace.Begin("Job " + opString(index), "job");
+
+        opLog::SetCapture(&job.Output);
+        NumErrors = 0;
+
+        try {
+            job.bResult = NormalModeFile(params, job.File);
+        } catch (...) {
+            job.Exception = std::current_exception();
+            opException::CaughtException();
+            queue->Cancel();
+        }
+
+        job.NumErrors = NumErrors;
+
+        // this file's trees are no longer needed
+        opTraceScope deletetrace("DeleteLoadedFiles", "memory");
+        FileNode::DeleteLoadedFiles();
+        deletetrace.End();
+
+        opLog::SetCapture(NULL);
+        queue->Finish(index);
+    }
+
+    opParameters::SetJobInstance(NULL);
+}
+
 opString opDriver::ToGeneratedPath(const opString& inpath) {
     const opParameters& p = opParameters::Get();
 
@@ -459,6 +708,9 @@ opString opDriver::GetOutputPath(const opParameters& p, const path& inputpath) {
 bool opDriver::NormalModeFile(const opParameters& p, const path& filename) {
     double totaltimestart = opTimer::GetTimeSeconds();
 
+    opTraceScope trace;
+    if (opTrace::IsEnabled()) trace.Begin(filename.string(), "file");
+
     // build the output filename strings...
     // fix this for ../ case (convert to string and find & replace...)
     opString sfile = GetOutputPath(p, filename);
@@ -470,51 +722,54 @@ bool opDriver::NormalModeFile(const opParameters& p, const path& filename) {
 
     if (!exists(outputpath)) create_directories(outputpath);
 
-    // lets check the timestamp...
-    if (!p.Force) {
-        time_t ohtime = last_write_time(filename);
-
-        // we want to rebuild upon upgrades / new builds
-        time_t opcpptime = opPlatform::GetOpCppTimeStamp();
-
-        if (exists(oohpath) && exists(ocpppath)) {
-            time_t oohtime = last_write_time(oohpath);
-            time_t ocpptime = last_write_time(ocpppath);
-
-            time_t dohtime = GetGeneratedDialectTimestamp(p);
+    // lets check the content hashes...
+    if (!p.Force && exists(oohpath) && exists(ocpppath)) {
+        opBuildManifest::Status status =
+            opBuildManifest::Check(sfile, DialectState);
 
+        if (status == opBuildManifest::DialectsChanged) {
             FileNode tempfile;
             tempfile.LoadDependencies(sfile + ".depend");
-            bool bNewDepend = tempfile.IsDependencyNewer(oohtime);
 
-            if (bNewDepend) {
-                if (p.Verbose) {
-                    Log("Included file newer than generated file, forcing "
-                        "recompile ...");
-                    Log("");
-                }
+            // the dialect entities it uses didn't change
+            if (tempfile.IsDialectDependencyCurrent()) {
+                opSet<opString> inputs = tempfile.GetDependencies();
+                inputs.Insert(filename.string());
+
+                opBuildManifest::Record(sfile, inputs, DialectState);
+
+                status = opBuildManifest::Current;
+            } else if (p.Verbose) {
+                Log("Dialect changed since generated file, forcing recompile "
+                    "...");
+                Log("");
             }
-            // up to date if ooh newer than oh, and ooh newer than opcpp build
-            else if (oohtime < opcpptime || ocpptime < opcpptime) {
-                if (p.Verbose) {
-                    Log(opPlatform::GetOpCppExecutableName() +
-                        " newer than generated file, forcing recompile ...");
-                    Log("");
-                }
-            } else if (oohtime <= dohtime || ocpptime <= dohtime) {
-                if (p.Verbose) {
-                    Log("Dialect newer than generated file, forcing recompile "
-                        "...");
-                    Log("");
-                }
-            } else if (oohtime > ohtime && ocpptime > ohtime) {
-                if (p.Verbose) Log(filename.string() + " is up to date");
+        } else if (status == opBuildManifest::Changed) {
+            if (p.Verbose) {
+                Log("Input changed since generated file, forcing recompile "
+                    "...");
+                Log("");
+            }
+        }
 
-                return true;
+        if (status == opBuildManifest::Current) {
+            if (p.Verbose) Log(filename.string() + " is up to date");
+
+            // -depfiles may be new since it was compiled
+            if (p.Depfiles) {
+                FileNode tempfile;
+                tempfile.LoadDependencies(sfile + ".depend");
+                tempfile.SaveDepfile(sfile + ".d", oohpath.string(),
+                                     ocpppath.string(), filename.string());
             }
+
+            return true;
         }
     }
 
+    // recorded again once it compiles
+    opBuildManifest::Forget(sfile);
+
     opError::Clear();
 
     // output compiling -file- to std out
@@ -522,6 +777,10 @@ bool opDriver::NormalModeFile(const opParameters& p, const path& filename) {
         Log(opString("Compiling ") + filename.string() + " ...");
     }
 
+    // track the dialect entities this file uses
+    opSet<opString> dialectentities;
+    DialectConsumer consumer(dialectentities);
+
     // load the oh file, it will be tracked elsewhere
     OPFileNode* filenode =
         FileNode::Load<OPFileNode>(filename.string(), opScanner::SM_NormalMode);
@@ -536,12 +795,13 @@ bool opDriver::NormalModeFile(const opParameters& p, const path& filename) {
         return false;
     }
 
+    // -benchmark scan and parse stop before printing
+    if (opBenchmark::GetMode() == opBenchmark::Scan ||
+        opBenchmark::GetMode() == opBenchmark::Parse)
+        return true;
+
     // no errors, let's print the output files
     try {
-        // Save dependencies file.
-        opString dependpath = sfile + ".depend";
-        filenode->SaveDependencies(dependpath);
-
         // open the output files for the generated code...
         FileWriteStream hfile(oohpath.string());
         FileWriteStream sfile(ocpppath.string());
@@ -555,9 +815,15 @@ bool opDriver::NormalModeFile(const opParameters& p, const path& filename) {
             filestream.SetDepths(oohpath.string());
 
             // files are open, now print to them
+            opTraceScope printtrace("PrintNode", "phase");
             filenode->PrintNode(filestream);
+            printtrace.End();
 
+            opTraceScope writetrace("Write", "io");
             filestream.Output();
+            opBenchmark::CountBytesEmitted(hfile.Size() + sfile.Size());
+            hfile.Close();
+            sfile.Close();
         } else {
             Log("Could not open output file(s)!");
             return false;
@@ -566,6 +832,23 @@ bool opDriver::NormalModeFile(const opParameters& p, const path& filename) {
         //??? ever
     }
 
+    // save dependencies file (after printing, which queries dialects too)
+    opTraceScope dependtrace("SaveDependencies", "io");
+    filenode->AddDialectDependencies(dialectentities);
+    filenode->SaveDependencies(sfile + ".depend");
+
+    if (p.Depfiles)
+        filenode->SaveDepfile(sfile + ".d", oohpath.string(),
+                              ocpppath.string(), filename.string());
+
+    opSet<opString> inputs = filenode->GetDependencies();
+    inputs.Insert(filename.string());
+
+    opBuildManifest::Record(sfile, inputs, DialectState);
+    opBuildManifest::AddGenerated(sfile);
+
+    dependtrace.End();
+
     // print xml!
     if (p.PrintXml) {
         try {
@@ -623,7 +906,7 @@ bool opDriver::ValidateDialectFiles(const opParameters& p) {
     while (i != end) {
         path filepath = (*i).GetString();
 
-        if (exists(filepath)) {
+        if (opPathCache::Exists(filepath)) {
             filepath = to_relative_path(filepath);
             DohFiles.insert(filepath);
             old = i;
@@ -647,7 +930,7 @@ bool opDriver::ValidateDialectFiles(const opParameters& p) {
             path filepath =
                 Dirs[d].GetString() / to_relative_path((*i).GetString());
 
-            if (exists(filepath)) {
+            if (opPathCache::Exists(filepath)) {
                 filepath = to_relative_path(filepath);
                 DohFiles.insert(filepath);
                 old = i;
@@ -683,45 +966,47 @@ bool opDriver::ValidateDialectFiles(const opParameters& p) {
     return true;
 }
 
-time_t opDriver::GetDialectTimestamp(const opParameters& p) {
-    // find the maximum timestamp on the dialects (input dialects, since we
-    // output every time)
-    time_t maxtime = 0;
+// options that change what gets generated
+opString opDriver::GetManifestOptions(const opParameters& p) {
+    opString options = current_path().string();
 
-    for (int i = 0; i < p.Dialects.size(); i++) {
-        // TODO - use generated dialects instead..
-        path filepath = p.Dialects[i].GetString();
+    for (int i = 0; i < p.Directories.size(); i++)
+        options += opString(";") + p.Directories[i];
 
-        // doh file exists?
-        if (exists(filepath)) {
-            maxtime = max(last_write_time(filepath), maxtime);
-        }
-    }
+    options += opString("|") + p.GeneratedDirectory.GetValue() + "|";
+
+    bool flags[] = {p.NoDebug,   p.Compact,      p.NoStandardIncludes,
+                    p.InlineAll, p.Ghosts,       p.Highlighting,
+                    p.Notations, p.PrintXml,     p.FixedSys,
+                    p.DeveloperMode};
+
+    for (size_t i = 0; i < sizeof(flags) / sizeof(flags[0]); i++)
+        options += flags[i] ? "1" : "0";
+
+    options += opString("|") + opString(p.OPMacroExpansionDepth.GetValue());
 
-    return maxtime;
+    return options;
 }
 
-time_t opDriver::GetGeneratedDialectTimestamp(const opParameters& p) {
-    // find the maximum timestamp on the dialects (input dialects, since we
-    // output every time)
-    time_t maxtime = 0;
+// identifies the dialect inputs as recorded in the manifest
+opString opDriver::GetDialectState(const opParameters& p) {
+    opString state;
 
-    for (int i = 0; i < p.Dialects.size(); i++) {
-        opString filestring = GetOutputPath(p, p.Dialects[i].GetString());
+    typedef opSet<path>::const_iterator fileit;
 
-        path filepath = (filestring + ".ooh").GetString();
+    for (fileit it = DohFiles.begin(); it != DohFiles.end(); ++it) {
+        opString output = GetOutputPath(p, *it);
 
-        // doh file exists?
-        if (exists(filepath)) {
-            maxtime = max(last_write_time(filepath), maxtime);
-        }
+        state += output + "\n" + opBuildManifest::GetInputState(output);
     }
 
-    return maxtime;
+    return opBuildManifest::HashString(state);
 }
 
 // read dialects
 bool opDriver::DialectMode(const opParameters& p) {
+    opTraceScope trace("DialectMode", "driver");
+
     opSet<path> files = GetDialectFiles();
 
     // if there are no files to compile, return false
@@ -737,10 +1022,18 @@ bool opDriver::DialectMode(const opParameters& p) {
     if (p.Verbose)  // spacing in verbose mode
         Log(' ');
 
+    // reading a new resident set
+    if (bResidentDialects && ResidentFiles.IsEmpty()) {
+        ResidentKey = GetResidentKey(p);
+        ResidentTime = time(NULL);
+    }
+
     for (fileit it = files.begin(); it != files.end(); ++it) {
         bResult = DialectModeFile(p, *it) ? bResult : false;
     }
 
+    if (!bResult) ReleaseResidentDialects();
+
     if (!p.Silent && files.size() > 1) {
         if (p.Verbose) {
             Log(' ');
@@ -765,6 +1058,9 @@ bool opDriver::DialectMode(const opParameters& p) {
 bool opDriver::DialectModeFile(const opParameters& p, const path& filename) {
     double totaltimestart = opTimer::GetTimeSeconds();
 
+    opTraceScope trace;
+    if (opTrace::IsEnabled()) trace.Begin(filename.string(), "file");
+
     opError::Clear();
 
     // output compiling -file- to std out
@@ -772,21 +1068,70 @@ bool opDriver::DialectModeFile(const opParameters& p, const path& filename) {
         Log(opString("Reading dialect ") + filename.string() + " ...");
     }
 
-    // load the oh file, it will be tracked elsewhere
-    DialectFileNode* filenode = FileNode::Load<DialectFileNode>(
-        filename.string(), opScanner::SM_DialectMode);
+    opString spath = GetOutputPath(p, filename);
+    path oohpath = (spath + ".ooh").GetString();
+    path ocpppath = (spath + ".ocpp").GetString();
+    path outputpath = oohpath.branch_path();
 
-    // filenode should be non-null even if there were errors
-    assert(filenode);
+    if (!exists(outputpath)) create_directories(outputpath);
 
-    if (opError::HasErrors()) {
-        if (p.PrintTree) filenode->PrintTree(filename.string());
+    // the outputs are current if the manifest says none of the inputs
+    // changed
+    bool bOutputs = !p.Force && exists(oohpath) && exists(ocpppath);
+    bool bCurrent =
+        bOutputs && opBuildManifest::Check(spath) == opBuildManifest::Current;
 
-        opError::Print();
+    // the registered tree is cached alongside, keyed by the inputs
+    opString cachepath = spath + ".dohcache";
 
-        return false;
+    // load the doh file (unless it's resident), it will be tracked elsewhere
+    DialectFileNode* filenode = NULL;
+    bool bLoaded = false;
+    bool bCached = false;
+
+    if (!ResidentFiles.Find(filename.string(), filenode)) {
+        bLoaded = true;
+
+        // current dialects skip the parse, anything else is reparsed
+        opString state = opBuildManifest::GetInputState(spath);
+
+        if (bCurrent && !state.IsEmpty()) {
+            opTraceScope cachetrace("ReadCache", "io");
+
+            filenode = node_cast<DialectFileNode>(
+                opDialectCache::Load(cachepath, state));
+        }
+
+        if (filenode) {
+            bCached = true;
+
+            opTraceScope phase("PostOperations", "phase");
+            filenode->PostOperations();
+        } else
+            filenode = FileNode::Load<DialectFileNode>(
+                filename.string(), opScanner::SM_DialectMode);
+
+        // filenode should be non-null even if there were errors
+        assert(filenode);
+
+        if (opError::HasErrors()) {
+            if (p.PrintTree) filenode->PrintTree(filename.string());
+
+            opError::Print();
+
+            return false;
+        }
+
+        if (bResidentDialects) {
+            filenode->SetResident(true);
+            ResidentFiles.Insert(filename.string(), filenode);
+        }
     }
 
+    DialectInputs.Insert(filename.string());
+    DialectInputs.Insert(filenode->GetDependencies().Begin(),
+                         filenode->GetDependencies().End());
+
     // check for file not found error
     // 	if (filenode->FileNotFoundError())
     // 	{
@@ -830,50 +1175,16 @@ bool opDriver::DialectModeFile(const opParameters& p, const path& filename) {
     // 		return false;
     // 	}
 
-    opString spath = GetOutputPath(p, filename);
-    path oohpath = (spath + ".ooh").GetString();
-    path ocpppath = (spath + ".ocpp").GetString();
-    path outputpath = oohpath.branch_path();
-
-    if (!exists(outputpath)) create_directories(outputpath);
-
     // handle dialect writing
     // we always want to read dialects though.
-    bool bwrite = true;
-    if (!p.Force) {
-        // we want to rebuild upon upgrades / new builds
-        if (exists(oohpath) && exists(filename)) {
-            time_t oohtime = last_write_time(oohpath);
-            time_t opcpptime = opPlatform::GetOpCppTimeStamp();
-            time_t dohtime = GetDialectTimestamp(p);
-
-            filenode->LoadDependencies(spath + ".depend");
-            bool bNewDepend = filenode->IsDependencyNewer(oohtime);
-
-            if (bNewDepend) {
-                if (p.Verbose) {
-                    Log("Included dialect newer than generated dialect file, "
-                        "forcing recompile ...");
-                    Log("");
-                }
-            } else if (oohtime < opcpptime) {
-                if (p.Verbose) {
-                    Log(opPlatform::GetOpCppExecutableName() +
-                        " newer than generated dialect file, forcing recompile "
-                        "...");
-                    Log("");
-                }
-            } else if (oohtime <= dohtime) {
-                if (p.Verbose) {
-                    Log("Dialect newer than generated dialect file, forcing "
-                        "recompile ...");
-                    Log("");
-                }
-            } else if (oohtime > dohtime) {
-                if (p.Verbose) Log(filename.string() + " is up to date");
-
-                bwrite = false;
-            }
+    bool bwrite = !bCurrent;
+    if (bOutputs && p.Verbose) {
+        if (bCurrent)
+            Log(filename.string() + " is up to date");
+        else {
+            Log("Dialect changed since generated dialect file, forcing "
+                "recompile ...");
+            Log("");
         }
     }
 
@@ -896,9 +1207,14 @@ bool opDriver::DialectModeFile(const opParameters& p, const path& filename) {
                 filestream.SetDepths(oohpath.string());
 
                 // files are open, now print to them
+                opTraceScope printtrace("PrintNode", "phase");
                 filenode->PrintDialectNode(filestream);
+                printtrace.End();
 
+                opTraceScope writetrace("Write", "io");
                 filestream.Output();
+                hfile.Close();
+                sfile.Close();
             } else {
                 Log("Could not open output file(s)!");
                 return false;
@@ -906,6 +1222,11 @@ bool opDriver::DialectModeFile(const opParameters& p, const path& filename) {
         } catch (opException::opCPP_Exception&) {
         }
 
+        opSet<opString> inputs = filenode->GetDependencies();
+        inputs.Insert(filename.string());
+
+        opBuildManifest::Record(spath, inputs);
+
         // print xml!
         if (p.PrintXml) {
             try {
@@ -929,6 +1250,23 @@ bool opDriver::DialectModeFile(const opParameters& p, const path& filename) {
         }
     }
 
+    if (p.Depfiles)
+        filenode->SaveDepfile(spath + ".d", oohpath.string(),
+                              ocpppath.string(), filename.string());
+
+    // cache a freshly parsed tree for the next run
+    if (bLoaded && !bCached) {
+        opString state = opBuildManifest::GetInputState(spath);
+
+        if (!state.IsEmpty() &&
+            !opDialectCache::Save(filenode, cachepath, state) && p.Verbose)
+            Log(filename.string() + " could not be cached");
+    }
+
+    // compile jobs share the dialect trees, so nothing may materialize
+    // lazily once they start
+    if (bLoaded) TerminalNode::MaterializeTree(filenode);
+
     double totaltimeend = opTimer::GetTimeSeconds();
     double totaltimeMs = (totaltimeend - totaltimestart) * 1000.0;
 
@@ -962,16 +1300,20 @@ bool opDriver::CleanMode(const opParameters& p) {
         string oohfilename = filename + ".ooh";
         string ocppfilename = filename + ".ocpp";
         string dependfilename = filename + ".depend";
+        string depfilename = filename + ".d";
 
         path oohpath = oohfilename;
         path ocpppath = ocppfilename;
         path dependpath = dependfilename;
+        path depfilepath = depfilename;
 
         if (exists(oohpath)) remove(oohpath);
 
         if (exists(ocpppath)) remove(ocpppath);
 
         if (exists(dependpath)) remove(dependpath);
+
+        if (exists(depfilepath)) remove(depfilepath);
     }
 
     /*=== remove .doh generated code ===*/
@@ -983,16 +1325,24 @@ bool opDriver::CleanMode(const opParameters& p) {
         string oohfilename = filename + ".ooh";
         string ocppfilename = filename + ".ocpp";
         string dependfilename = filename + ".depend";
+        string depfilename = filename + ".d";
+        string cachefilename = filename + ".dohcache";
 
         path oohpath = oohfilename;
         path ocpppath = ocppfilename;
         path dependpath = dependfilename;
+        path depfilepath = depfilename;
+        path cachepath = cachefilename;
 
         if (exists(oohpath)) remove(oohpath);
 
         if (exists(ocpppath)) remove(ocpppath);
 
         if (exists(dependpath)) remove(dependpath);
+
+        if (exists(depfilepath)) remove(depfilepath);
+
+        if (exists(cachepath)) remove(cachepath);
     }
 
     /*=== remove .index files ===*/
@@ -1007,28 +1357,30 @@ bool opDriver::CleanMode(const opParameters& p) {
 
     if (exists(ocppindexpath)) remove(ocppindexpath);
 
-    /*=== remove .target files ===*/
+    path outputpath = p.GeneratedDirectory.GetString();
 
-    int size = p.Depend.size();
+    for (int i = 0; exists(Globber::GetShardPath(outputpath, i)); i++)
+        remove(Globber::GetShardPath(outputpath, i));
 
-    for (int i = 0; i < size; i++) {
-        opString filestring = p.Depend[i];
-        path filepath = filestring.GetString();
-        opString targetfile = filepath.leaf().c_str();
+    string globshards = GetOutputPath(p, "Generated.globshards");
+    path globshardspath = globshards;
 
-        targetfile += ".target";
+    if (exists(globshardspath)) remove(globshardspath);
 
-        path targetpath =
-            p.GeneratedDirectory.GetString() / targetfile.GetString();
+    /*=== remove the build manifest ===*/
 
-        if (exists(targetpath)) remove(targetpath);
-    }
+    string manifest = GetOutputPath(p, "Generated.manifest");
+    path manifestpath = manifest;
+
+    if (exists(manifestpath)) remove(manifestpath);
 
     return true;
 }
 
 // perform globbing
 bool opDriver::GlobMode(const opParameters& p) {
+    opTraceScope trace("GlobMode", "driver");
+
     Globber Globberobj;
 
     // test settings
@@ -1075,19 +1427,20 @@ bool opDriver::GlobMode(const opParameters& p) {
 }
 
 bool opDriver::CodeCurrent() {
-    // foreach dialect we have...
+    // foreach code file we have...
     // and all dependencies, are we up to date?
-    // are we up to date?
+    const opParameters& p = opParameters::Get();
+
     opSet<path>::iterator it = OhFiles.begin();
     opSet<path>::iterator end = OhFiles.end();
 
-    time_t opcpptime = opPlatform::GetOpCppTimeStamp();
+    opString dialects = GetDialectState(p);
 
     while (it != end) {
         const path& ohfilepath = *it;
 
         // get the output path
-        opString filestring = GetOutputPath(opParameters::Get(), ohfilepath);
+        opString filestring = GetOutputPath(p, ohfilepath);
 
         path oohfilepath = (filestring + ".ooh").GetString();
         path ocppfilepath = (filestring + ".ocpp").GetString();
@@ -1096,19 +1449,12 @@ bool opDriver::CodeCurrent() {
 
         if (!exists(ocppfilepath)) return false;
 
-        time_t ohtime = last_write_time(ohfilepath);
-        time_t oohtime = last_write_time(oohfilepath);
-        time_t ocpptime = last_write_time(ocppfilepath);
-
-        if (ohtime > oohtime || ohtime > ocpptime || opcpptime > oohtime ||
-            opcpptime > ocpptime)
+        if (p.Depfiles && !exists((filestring + ".d").GetString()))
             return false;
 
-        // now check dependencies
-        FileNode file;
-        file.LoadDependencies(filestring + ".depend");
-
-        if (file.IsDependencyNewer(oohtime)) return false;
+        if (opBuildManifest::Check(filestring, dialects) !=
+            opBuildManifest::Current)
+            return false;
 
         ++it;
     }
@@ -1117,18 +1463,18 @@ bool opDriver::CodeCurrent() {
 }
 
 bool opDriver::DialectsCurrent() {
-    // foreach code files we have...
+    // foreach dialect we have...
     // are we up to date?
+    const opParameters& p = opParameters::Get();
+
     opSet<path>::iterator it = DohFiles.begin();
     opSet<path>::iterator end = DohFiles.end();
 
-    time_t opcpptime = opPlatform::GetOpCppTimeStamp();
-
     while (it != end) {
         const path& dohfilepath = *it;
 
         // get the output path
-        opString filestring = GetOutputPath(opParameters::Get(), dohfilepath);
+        opString filestring = GetOutputPath(p, dohfilepath);
 
         path oohfilepath = (filestring + ".ooh").GetString();
         path ocppfilepath = (filestring + ".ocpp").GetString();
@@ -1137,19 +1483,11 @@ bool opDriver::DialectsCurrent() {
 
         if (!exists(ocppfilepath)) return false;
 
-        time_t dohtime = last_write_time(dohfilepath);
-        time_t oohtime = last_write_time(oohfilepath);
-        time_t ocpptime = last_write_time(ocppfilepath);
-
-        if (dohtime > oohtime || dohtime > ocpptime || opcpptime > oohtime ||
-            opcpptime > ocpptime)
+        if (p.Depfiles && !exists((filestring + ".d").GetString()))
             return false;
 
-        // now check dependencies
-        FileNode file;
-        file.LoadDependencies(filestring + ".depend");
-
-        if (file.IsDependencyNewer(oohtime)) return false;
+        if (opBuildManifest::Check(filestring) != opBuildManifest::Current)
+            return false;
 
         ++it;
     }
@@ -20,15 +20,16 @@
 
 ostream* opLog::o = &cout;
 opString opLog::lastLog = "first_log";
+THREAD_LOCAL opArray<opString>* opLog::Capture = NULL;
 
 ///
 /// opError
 ///
 
-opList<ErrorInfo> opError::Errors;
+THREAD_LOCAL opList<ErrorInfo> opError::Errors;
 opString opError::ParseErrors[Tokens_MAX + 1];
-Token opError::ContextToken = Tokens_MAX;
-opNode* opError::ContextNode = NULL;
+THREAD_LOCAL Token opError::ContextToken = Tokens_MAX;
+THREAD_LOCAL opNode* opError::ContextNode = NULL;
 int opError::MaxErrorNameLength = 40;
 
 // This method initializes all the parse errors.
@@ -448,7 +449,7 @@ void opError::Add(FileNode* file, int line, const opString& error) {
 
     // NOTE: using absolute paths for errors now.
     path filepath = file->GetInputName().GetString();
-    filepath = initial_path() / filepath;
+    filepath = current_path() / filepath;
     filepath.normalize();
 
     opString nativefile = filepath.string();
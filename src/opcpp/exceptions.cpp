@@ -13,7 +13,7 @@
 
 #include "opcpp/opcpp.h"
 
-int opException::ExceptionCount = 0;
+THREAD_LOCAL int opException::ExceptionCount = 0;
 
-opException::ExceptionType opException::ExceptionOverride =
+THREAD_LOCAL opException::ExceptionType opException::ExceptionOverride =
     opException::DefaultException;
@@ -17,7 +17,7 @@
 /// ExpandCallNode
 ///
 
-int ExpandCallNode::ExpansionDepth = 0;
+THREAD_LOCAL int ExpandCallNode::ExpansionDepth = 0;
 
 ///
 /// OPMacroNode
@@ -13,14 +13,14 @@
 
 #include "opcpp/opcpp.h"
 
-bool opStringStream::bLineDirectives =
+THREAD_LOCAL bool opStringStream::bLineDirectives =
     true;  // true - should be true, just for testing!
 
 //
 // FileNode
 //
 
-opArray<FileNode*> FileNode::FileTable;
+THREAD_LOCAL opArray<FileNode*> FileNode::FileTable;
 
 FileNode* FileNode::GetLoadedFile(const opString& filename) {
     int size = FileTable.Size();
@@ -38,6 +38,13 @@ FileNode::~FileNode() {
         opArray<FileNode*>::iterator item = FileTable.Find(this);
         if (item != end) *item = NULL;
     }
+
+    // the tree goes first, then the arena it's in is freed at once
+    if (Arena) {
+        DeleteChildren();
+
+        delete Arena;
+    }
 }
 
 void FileNode::UnRegisterLoadedFiles() {
@@ -47,11 +54,18 @@ void FileNode::UnRegisterLoadedFiles() {
 }
 
 void FileNode::DeleteLoadedFiles() {
+    opArray<FileNode*> resident;
+
     for (int i = 0; i < FileTable.Size(); i++) {
-        if (FileTable[i]) delete FileTable[i];
+        if (!FileTable[i]) continue;
+
+        if (FileTable[i]->IsResident())
+            resident.PushBack(FileTable[i]);
+        else
+            delete FileTable[i];
     }
 
-    FileTable.clear();
+    FileTable.Swap(resident);
 }
 
 //
@@ -62,7 +76,7 @@ path FindIncludedFile(const path& filepath) {
     const opParameters& p = opParameters::Get();
 
     // if this exists, use it
-    if (exists(filepath)) return filepath;
+    if (opPathCache::Exists(filepath)) return filepath;
 
     typedef vector<opString>::const_iterator dequeit;
 
@@ -71,14 +85,14 @@ path FindIncludedFile(const path& filepath) {
     for (dequeit it = p.Directories.begin(); it != dend; ++it) {
         path combined = (*it).GetString() / filepath;
 
-        if (exists(combined)) return combined;
+        if (opPathCache::Exists(combined)) return combined;
     }
 
     dequeit fdend = p.FileDirectories.end();
     for (dequeit it = p.FileDirectories.begin(); it != fdend; ++it) {
         path combined = (*it).GetString() / filepath;
 
-        if (exists(combined)) return combined;
+        if (opPathCache::Exists(combined)) return combined;
     }
 
     return filepath;
@@ -94,13 +108,22 @@ opString OPIncludeNode::GetFullFileString() {
     currentpath = FindIncludedFile(currentpath);
     currentpath = currentpath.branch_path();
 
+    // every file in a directory resolves an include the same way
+    opString resolved;
+
+    if (opPathCache::FindInclude(currentpath.string(), filestring, resolved))
+        return resolved;
+
     path currentcombined = currentpath / filepath;
-    if (exists(currentcombined)) {
+    if (opPathCache::Exists(currentcombined)) {
         filepath = currentcombined;
     } else {
         filepath = FindIncludedFile(filepath);
     }
 
+    opPathCache::StoreInclude(currentpath.string(), filestring,
+                              filepath.string());
+
     return filepath.string();
 }
 
@@ -202,7 +225,8 @@ void FileNode::AddDependency(const opString& filepath) {
 }
 
 void FileNode::SaveDependencies(const opString& filepath) {
-    std::ofstream ofs(filepath.GetCString());
+    // only rewritten if the dependencies changed
+    FileWriteStream ofs(filepath);
 
     opSet<opString>::iterator it = Dependencies.begin();
     opSet<opString>::iterator end = Dependencies.end();
@@ -211,6 +235,18 @@ void FileNode::SaveDependencies(const opString& filepath) {
         ofs << *it << endl;
         ++it;
     }
+
+    if (DialectDependencies.IsEmpty()) return;
+
+    ofs << "[dialect]" << endl;
+
+    opMap<opString, opString>::iterator dit = DialectDependencies.Begin();
+    opMap<opString, opString>::iterator dend = DialectDependencies.End();
+
+    while (dit != dend) {
+        ofs << dit->first << " " << dit->second << endl;
+        ++dit;
+    }
 }
 
 bool FileNode::LoadDependencies(const opString& filepath) {
@@ -225,7 +261,24 @@ bool FileNode::LoadDependencies(const opString& filepath) {
 
         size = files.Size();
 
-        for (int i = 0; i < size; i++) Dependencies.Insert(files[i].Trim());
+        bool bDialect = false;
+
+        for (int i = 0; i < size; i++) {
+            opString line = files[i].Trim();
+
+            if (line == "[dialect]")
+                bDialect = true;
+            else if (!bDialect)
+                Dependencies.Insert(line);
+            else {
+                // entity fingerprint
+                int space;
+
+                if (line.Find(" ", space))
+                    DialectDependencies.Insert(line.Left(space),
+                                               line.Right(space));
+            }
+        }
 
         return true;
     }
@@ -233,6 +286,99 @@ bool FileNode::LoadDependencies(const opString& filepath) {
     return false;
 }
 
+void FileNode::AddDialectDependencies(const opSet<opString>& entities) {
+    opSet<opString>::const_iterator it = entities.Begin();
+    opSet<opString>::const_iterator end = entities.End();
+
+    while (it != end) {
+        DialectDependencies[*it] = DialectTracker::GetFingerprint(*it);
+        ++it;
+    }
+}
+
+bool FileNode::IsDialectDependencyCurrent() {
+    if (DialectDependencies.IsEmpty()) return false;
+
+    opMap<opString, opString>::iterator it = DialectDependencies.Begin();
+    opMap<opString, opString>::iterator end = DialectDependencies.End();
+
+    while (it != end) {
+        if (DialectTracker::GetFingerprint(it->first) != it->second)
+            return false;
+
+        ++it;
+    }
+
+    return true;
+}
+
+namespace {
+
+// escapes a path for make (and ninja's depfile parser)
+opString DepfilePath(const opString& filepath) {
+    opString escaped;
+
+    for (int i = 0; i < filepath.Length(); i++) {
+        char c = filepath[i];
+
+        if (c == ' ' || c == '#')
+            escaped += '\\';
+        else if (c == '$')
+            escaped += '$';
+
+        escaped += c;
+    }
+
+    return escaped;
+}
+
+}  // namespace
+
+void FileNode::SaveDepfile(const opString& filepath, const opString& oohpath,
+                           const opString& ocpppath, const opString& source) {
+    opSet<opString> prerequisites = Dependencies;
+    bool bAllDialects = false;
+
+    opMap<opString, opString>::iterator dit = DialectDependencies.Begin();
+    opMap<opString, opString>::iterator dend = DialectDependencies.End();
+
+    while (dit != dend) {
+        DialectTracker::GetEntityFiles(dit->first, prerequisites);
+
+        // a name or extension lookup that missed depends on every dialect
+        // file, since any of them could add the definition
+        if (dit->first == "names" || dit->first == "extensions")
+            bAllDialects = true;
+
+        ++dit;
+    }
+
+    if (bAllDialects) {
+        const opSet<opString>& dialects = opDriver::GetDialectInputs();
+
+        prerequisites.Insert(dialects.Begin(), dialects.End());
+    }
+
+    prerequisites.Erase(source);
+
+    // only rewritten if the dependencies changed
+    FileWriteStream ofs(filepath);
+
+    ofs << DepfilePath(oohpath) << " " << DepfilePath(ocpppath) << ": "
+        << DepfilePath(source);
+
+    opSet<opString>::iterator it = prerequisites.Begin();
+    opSet<opString>::iterator end = prerequisites.End();
+
+    for (; it != end; ++it) ofs << " \\" << endl << "  " << DepfilePath(*it);
+
+    ofs << endl;
+
+    // empty rules so deleted files don't break the build (like gcc -MP)
+    for (it = prerequisites.Begin(); it != end; ++it)
+        ofs << endl << DepfilePath(*it) << ":" << endl;
+}
+
 bool FileNode::IsDependencyNewer(time_t timestamp) {
     // if we find a newer one, return true
     opSet<opString>::iterator it = Dependencies.begin();
@@ -243,8 +389,8 @@ bool FileNode::IsDependencyNewer(time_t timestamp) {
         opString filepath = *it;
 
         path dependpath = filepath.GetString();
-        if (exists(dependpath)) {
-            time_t dependtime = last_write_time(dependpath);
+        if (opPathCache::Exists(dependpath)) {
+            time_t dependtime = opPathCache::LastWriteTime(dependpath);
 
             if (dependtime > timestamp) return true;
         } else
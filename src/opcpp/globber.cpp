@@ -61,53 +61,83 @@ bool Globber::Glob(const opParameters& p) {
 
     path outputpath = p.GeneratedDirectory.GetString();
 
+    double starttime = opTimer::GetTimeSeconds();
+
     set<path> oohfiles;
     set<path> ocppfiles;
 
-    FindFilesInDirectoryRecursive(outputpath, ".ooh", oohfiles);
-    FindFilesInDirectoryRecursive(outputpath, ".ocpp", ocppfiles);
+    // the build manifest knows what's been generated, otherwise walk
+    // the generated directory
+    opSet<opString> generated;
+    bool bListed = opBuildManifest::GetGenerated(generated);
+
+    if (bListed) {
+        opSet<opString>::iterator it = generated.Begin();
+        opSet<opString>::iterator end = generated.End();
+
+        while (it != end) {
+            path oohpath = (*it + ".ooh").GetString();
+            path ocpppath = (*it + ".ocpp").GetString();
+
+            if (exists(oohpath)) oohfiles.insert(oohpath);
+
+            if (exists(ocpppath)) ocppfiles.insert(ocpppath);
+
+            ++it;
+        }
+    } else {
+        FindFilesInDirectoryRecursive(outputpath, ".ooh", oohfiles);
+        FindFilesInDirectoryRecursive(outputpath, ".ocpp", ocppfiles);
+    }
+
+    double findtime = opTimer::GetTimeSeconds();
 
     typedef set<path>::const_iterator pathit;
 
+    // pair ooh and ocpp files by their path without the extension
+    opHashTable<opString, path> ocppstems;
+
+    pathit ocppend = ocppfiles.end();
+    for (pathit ocppit = ocppfiles.begin(); ocppit != ocppend; ++ocppit)
+        ocppstems.Insert(opString(ocppit->string()).RLeft(5), *ocppit);
+
     // find the valid oh files
     vector<ohfileinfo> validohfiles;
+    opSet<opString> paired;
 
     pathit oohend = oohfiles.end();
     for (pathit oohit = oohfiles.begin(); oohit != oohend; ++oohit) {
-        pathit ocppend = ocppfiles.end();
-        for (pathit ocppit = ocppfiles.begin(); ocppit != ocppend; ++ocppit) {
-            // now we want to remove their extensions
-            path oohpath = (*oohit);
-            path ocpppath = (*ocppit);
-
-            opString ocppstring = ocpppath.string();
-            opString oohstring = oohpath.string();
+        path oohpath = (*oohit);
+        path ocpppath;
 
-            ocppstring = ocppstring.RLeft(5);
-            oohstring = oohstring.RLeft(4);
+        opString oohstring = oohpath.string();
+        oohstring = oohstring.RLeft(4);
 
-            // potential oh file!
-            if (ocppstring == oohstring) {
-                // now convert the path...
-                opString ohstring = oohstring;
+        // potential oh file!
+        if (ocppstems.Find(oohstring, ocpppath)) {
+            paired.Insert(oohstring);
 
-                ohstring = opDriver::FromGeneratedPath(ohstring);
+            // now convert the path...
+            opString ohstring = oohstring;
 
-                // ohstring = ohstring.Replace("_up/","../");
+            ohstring = opDriver::FromGeneratedPath(ohstring);
 
-                // ohstring = ohstring.Right(outputpath.string() + "/");
-                path ohpath = ohstring.GetString();
+            path ohpath = ohstring.GetString();
 
-                // found a valid oh file!
-                if (exists(ohpath)) {
-                    if (opString(ohpath.leaf().c_str()).Right('.') == extension)
-                        validohfiles.push_back(
-                            ohfileinfo(ohpath, oohpath, ocpppath));
-                }
+            // found a valid oh file!
+            if (opPathCache::Exists(ohpath)) {
+                if (opString(ohpath.leaf().c_str()).Right('.') == extension)
+                    validohfiles.push_back(
+                        ohfileinfo(ohpath, oohpath, ocpppath));
             }
         }
     }
 
+    // remember what the walk found for next time
+    if (!bListed) opBuildManifest::SetGenerated(paired);
+
+    double pairtime = opTimer::GetTimeSeconds();
+
     // find the dialect doh files
     // 	pathit dohend = dohfiles.end();
     // 	for(pathit dohit = dohfiles.begin(); dohit != dohend; ++dohit)
@@ -143,7 +173,22 @@ bool Globber::Glob(const opParameters& p) {
     // we always build the ocpp index
     // determine whether or not to update the ocpp index (yes always)
     path sourceindex = outputpath / "Generated.ocppindex";
-    UpdateIndex<false>(validohfiles, sourceindex, p);
+
+    if (p.GlobShards.GetValue() > 0)
+        UpdateShards(validohfiles, outputpath, p);
+    else
+        UpdateIndex<false>(validohfiles, sourceindex, p);
+
+    double endtime = opTimer::GetTimeSeconds();
+
+    if (p.Verbose) {
+        Log(opString("Globber: ") + (int)oohfiles.size() + " ooh, " +
+            (int)ocppfiles.size() + " ocpp files " +
+            (bListed ? "listed" : "found") + " in " +
+            (findtime - starttime) * 1000.0 + " ms, paired in " +
+            (pairtime - findtime) * 1000.0 + " ms, indexes written in " +
+            (endtime - pairtime) * 1000.0 + " ms");
+    }
 
     return true;
 }
@@ -151,59 +196,23 @@ bool Globber::Glob(const opParameters& p) {
 template <bool bheader>
 void Globber::UpdateIndex(const vector<ohfileinfo>& files,
                           const path& indexpath, const opParameters& p) {
-    bool bForce = p.Force;
-
-    if (!exists(indexpath)) bForce = true;
-
-    // we need to determine if
-    // iterate over all files
-    bool bNewer = false;
-    if (!bForce) {
-        time_t indextime = last_write_time(indexpath);
-        time_t opcpptime = opPlatform::GetOpCppTimeStamp();
-
-        for (size_t i = 0; i < files.size(); i++) {
-            time_t ohtime = last_write_time(files[i].ohfilepath);
-
-            time_t generatedtime = bheader
-                                       ? last_write_time(files[i].oohfilepath)
-                                       : last_write_time(files[i].ocppfilepath);
-
-            // the index condition is the important one
-            // the header condition is not so important - that just says that an
-            // oh file wasn't build (oops)
-            if (indextime < opcpptime) {
-                if (p.Verbose)
-                    Log(opPlatform::GetOpCppExecutableName() +
-                        " newer than index, forcing glob");
-
-                bNewer = true;
-                break;
-            }
-
-            if (generatedtime > ohtime && generatedtime > indextime) {
-                bNewer = true;
-                break;
-            }
-        }
-    }
+    // the index is regenerated each time, it's only replaced
+    // when its contents change
+    bool bChanged = WriteIndex<bheader>(files, indexpath, p);
 
     string indexname = bheader ? "oohindex" : "ocppindex";
 
-    if (bNewer || bForce) {
-        if (p.Verbose)
-            Log(string("Globber: ") + indexname +
-                " out of date, rebuilding...");
-        WriteIndex<bheader>(files, indexpath, p);
-    } else {
-        if (p.Verbose)
+    if (p.Verbose) {
+        if (bChanged)
+            Log(string("Globber: ") + indexname + " out of date, rebuilt");
+        else
             Log(string("Globber: ") + indexname + " up to date, skipping...");
     }
 }
 
 template <bool bheader>
-void Globber::WriteIndex(const vector<ohfileinfo>& files, const path& indexpath,
-                         const opParameters& p) {
+bool Globber::WriteIndex(const vector<ohfileinfo>& files, const path& indexpath,
+                         const opParameters& p, bool bdialects) {
     // first, create the stream and verify it works
     FileWriteStream o(indexpath.string());
 
@@ -265,6 +274,9 @@ void Globber::WriteIndex(const vector<ohfileinfo>& files, const path& indexpath,
 
         path outputpath = p.GeneratedDirectory.GetString();
 
+        // (only one shard includes the dialect sources)
+        if (!bdialects) dend = pdialects.begin();
+
         for (diterator dit = pdialects.begin(); dit != dend; ++dit) {
             path dialectpath = *dit;
 
@@ -314,7 +326,13 @@ void Globber::WriteIndex(const vector<ohfileinfo>& files, const path& indexpath,
 
         // write the guard footer
         o << "#endif//header" << endl << endl;
+
+        o.Close();
+
+        return o.IsChanged();
     }
+
+    return false;
 }
 
 template <bool bheader>
@@ -353,6 +371,185 @@ void Globber::WriteDialectList(FileWriteStream& o,
     }
 }
 
+//
+// Globber Shards
+//
+
+path Globber::GetShardPath(const path& outputpath, int shard) {
+    opString name = opString("Generated_") + shard + ".ocppindex";
+
+    return outputpath / name.GetString();
+}
+
+void Globber::UpdateShards(const vector<ohfileinfo>& files,
+                           const path& outputpath, const opParameters& p) {
+    int numshards = p.GlobShards.GetValue();
+
+    vector<vector<ohfileinfo> > shards(numshards);
+    AssignShards(files, shards, outputpath / "Generated.globshards");
+
+    int changed = 0;
+
+    for (int i = 0; i < numshards; i++) {
+        if (WriteIndex<false>(shards[i], GetShardPath(outputpath, i), p,
+                              i == 0))
+            changed++;
+    }
+
+    // remove shards left over from a larger count
+    for (int i = numshards; exists(GetShardPath(outputpath, i)); i++)
+        remove(GetShardPath(outputpath, i));
+
+    // the full index just includes every shard
+    path indexpath = outputpath / "Generated.ocppindex";
+    FileWriteStream o(indexpath.string());
+
+    if (o.is_open()) {
+        o << "/*" << endl;
+        o << "\tGlob File:     " << indexpath.string() << endl;
+        o << "\topCPP Version: " << opString(opVersion::GetVersion()) << endl;
+        o << "\tBuild Date:    " << __DATE__ << " at " << __TIME__ << endl;
+        o << "*/" << endl << endl;
+
+        if (!p.Compact)
+            o << "//compile the source shards (or compile each separately)"
+              << endl;
+
+        for (int i = 0; i < numshards; i++)
+            o << "#include \"" << GetShardPath("", i).string() << "\""
+              << endl;
+
+        o << endl;
+    }
+
+    if (p.Verbose) {
+        Log(opString("Globber: ") + changed + " of " + numshards +
+            " ocppindex shards rebuilt");
+    }
+}
+
+namespace {
+
+struct ShardFile {
+    ShardFile() : Index(0), Size(0), Shard(-1) {}
+
+    int Index;
+    unsigned long long Size;
+    int Shard;
+
+    // largest first, then by name (the input order)
+    bool operator<(const ShardFile& other) const {
+        if (Size != other.Size) return Size > other.Size;
+
+        return Index < other.Index;
+    }
+};
+
+int LightestShard(const vector<unsigned long long>& sizes) {
+    int lightest = 0;
+
+    for (size_t i = 1; i < sizes.size(); i++) {
+        if (sizes[i] < sizes[lightest]) lightest = (int)i;
+    }
+
+    return lightest;
+}
+
+}  // namespace
+
+void Globber::AssignShards(const vector<ohfileinfo>& files,
+                           vector<vector<ohfileinfo> >& shards,
+                           const path& assignpath) {
+    int numshards = (int)shards.size();
+
+    // read the last assignment (unless the shard count changed)
+    opMap<opString, int> previous;
+    std::ifstream ifs(assignpath.string().c_str(), ios::in);
+
+    if (ifs.is_open()) {
+        opString file;
+        opArray<opString> lines;
+
+        file.LoadFile(ifs);
+        file.Tokenize('\n', lines);
+
+        if (lines.Size() && lines[0] == opString("shards ") + numshards) {
+            for (int i = 1; i < lines.Size(); i++) {
+                int space;
+
+                // <shard> <oh file>
+                if (lines[i].Find(" ", space))
+                    previous[lines[i].Right(space)] =
+                        atoi(lines[i].Left(space).GetCString());
+            }
+        }
+    }
+
+    vector<ShardFile> sorted(files.size());
+    vector<unsigned long long> sizes(numshards, 0);
+    unsigned long long total = 0;
+
+    for (size_t i = 0; i < files.size(); i++) {
+        ShardFile& shardfile = sorted[i];
+        shardfile.Index = (int)i;
+
+        if (exists(files[i].ocppfilepath))
+            shardfile.Size = file_size(files[i].ocppfilepath);
+
+        total += shardfile.Size;
+
+        int shard;
+
+        if (previous.Find(files[i].ohfilepath.string(), shard) && shard >= 0 &&
+            shard < numshards) {
+            shardfile.Shard = shard;
+            sizes[shard] += shardfile.Size;
+        }
+    }
+
+    // new files go to the lightest shard, largest first
+    std::sort(sorted.begin(), sorted.end());
+
+    for (size_t i = 0; i < sorted.size(); i++) {
+        if (sorted[i].Shard != -1) continue;
+
+        sorted[i].Shard = LightestShard(sizes);
+        sizes[sorted[i].Shard] += sorted[i].Size;
+    }
+
+    // far out of balance (files were removed or grew), redistribute
+    unsigned long long heaviest = 0;
+
+    for (int i = 0; i < numshards; i++) heaviest = max(heaviest, sizes[i]);
+
+    if ((int)sorted.size() > numshards &&
+        heaviest > 2 * (total / numshards + 1)) {
+        sizes.assign(numshards, 0);
+
+        for (size_t i = 0; i < sorted.size(); i++) {
+            sorted[i].Shard = LightestShard(sizes);
+            sizes[sorted[i].Shard] += sorted[i].Size;
+        }
+    }
+
+    // shards list files in their usual order
+    vector<int> assigned(files.size());
+
+    for (size_t i = 0; i < sorted.size(); i++)
+        assigned[sorted[i].Index] = sorted[i].Shard;
+
+    FileWriteStream o(assignpath.string());
+
+    o << "shards " << opString(numshards) << endl;
+
+    for (size_t i = 0; i < files.size(); i++) {
+        shards[assigned[i]].push_back(files[i]);
+
+        o << opString(assigned[i]) << " " << files[i].ohfilepath.string()
+          << endl;
+    }
+}
+
 //
 // Globber Utility Functions
 //
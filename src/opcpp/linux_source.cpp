@@ -12,6 +12,7 @@
 ///****************************************************************
 
 #include <stdlib.h>
+#include <sys/resource.h>
 #include <sys/time.h>
 #include <unistd.h>
 #include "opcpp/opcpp.h"
@@ -64,6 +65,15 @@ bool opPlatform::ParseExeLocation(const opString& cmdarg) {
     return true;
 }
 
+// peak resident set size
+long long opPlatform::GetPeakMemoryKb() {
+    rusage usage;
+
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+
+    return usage.ru_maxrss;
+}
+
 /*=== timing ===*/
 
 double timing::opTimer::GetTimeSeconds() {
@@ -13,6 +13,7 @@
 
 #include <mach-o/dyld.h>
 #include <stdlib.h>
+#include <sys/resource.h>
 #include <sys/time.h>
 #include <unistd.h>
 #include "opcpp/opcpp.h"
@@ -60,6 +61,15 @@ bool opPlatform::ParseExeLocation(const opString& cmdarg) {
     return true;
 }
 
+// peak resident set size (reported in bytes on mac)
+long long opPlatform::GetPeakMemoryKb() {
+    rusage usage;
+
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+
+    return usage.ru_maxrss / 1024;
+}
+
 /*=== timing ===*/
 
 double timing::opTimer::GetTimeSeconds() {
@@ -13,13 +13,146 @@
 
 #include "opcpp/opcpp.h"
 
+ExpandableNode::~ExpandableNode() {
+    if (bShares) Unshare(this);
+}
+
+stacked<ExpandableNode> ExpandableNode::Expand(opNode* body,
+                                               const vector<opString>& names,
+                                               const vector<opNode*>& values) {
+    stacked<ExpandableNode> expansion = NEWNODE(ExpandableNode);
+
+    expansion->CopyBasics(body);
+    expansion->bShares = true;
+
+    vector<opSymbol> symbols;
+
+    for (size_t i = 0; i < names.size(); i++)
+        symbols.push_back(opSymbol::Intern(names[i]));
+
+    expansion->ExpandChildren(body, *expansion, symbols, values);
+
+    return expansion;
+}
+
+void ExpandableNode::ExpandChildren(opNode* source, opNode* target,
+                                    const vector<opSymbol>& names,
+                                    const vector<opNode*>& values) {
+    iterator i = source->GetBegin();
+    iterator end = source->GetEnd();
+
+    while (i != end) {
+        opNode* child = *i;
+        ++i;
+
+        if (node_cast<TerminalNode>(child)) {
+            int match = FindArgument(child, names);
+
+            if (match < 0)
+                target->ShareNode(child);
+            else
+                AppendReplaced(child, target, match, names, values);
+
+            continue;
+        }
+
+        if (!ContainsArgument(child, names)) {
+            target->ShareNode(child);
+            continue;
+        }
+
+        // plain blocks are copied without their children, anything else
+        // is cloned and replaced as a whole
+        stacked<opNode> copy(NULL);
+
+        if (BraceBlockNode* brace = node_cast<BraceBlockNode>(child))
+            copy = CopyBlock(brace);
+        else if (ParenBlockNode* paren = node_cast<ParenBlockNode>(child))
+            copy = CopyBlock(paren);
+        else if (BracketBlockNode* bracket = node_cast<BracketBlockNode>(child))
+            copy = CopyBlock(bracket);
+        else if (AngledBlockNode* angled = node_cast<AngledBlockNode>(child))
+            copy = CopyBlock(angled);
+        else {
+            AppendReplaced(child, target, 0, names, values);
+            continue;
+        }
+
+        // attach the copy first - if expanding it throws, the shared
+        // nodes under it are still reachable by the root's Unshare
+        opNode* block = *copy;
+
+        target->AppendNode(copy);
+
+        ExpandChildren(child, block, names, values);
+    }
+}
+
+void ExpandableNode::AppendReplaced(opNode* node, opNode* target, int first,
+                                    const vector<opSymbol>& names,
+                                    const vector<opNode*>& values) {
+    // the node is replaced in a scratch parent, the way ReplaceNodes would
+    // replace it in its own
+    stacked<ExpandableNode> scratch = NEWNODE(ExpandableNode);
+    stacked<opNode> cloned = node->CloneGeneric();
+
+    scratch->AppendNode(cloned);
+
+    for (int i = first; i < (int)names.size(); i++)
+        DoReplacement(*scratch, names[i], values[i]);
+
+    target->MoveNodes(target->GetEnd(), *scratch, scratch->GetBegin(),
+                      scratch->GetEnd());
+
+    scratch.Delete();
+}
+
+int ExpandableNode::FindArgument(opNode* node,
+                                 const vector<opSymbol>& names) {
+    TerminalNode* terminal = (TerminalNode*)node;
+
+    for (int i = 0; i < (int)names.size(); i++)
+        if (terminal->Is(names[i])) return i;
+
+    return -1;
+}
+
+bool ExpandableNode::ContainsArgument(opNode* node,
+                                      const vector<opSymbol>& names) {
+    if (node_cast<TerminalNode>(node)) return FindArgument(node, names) >= 0;
+
+    iterator i = node->GetBegin();
+    iterator end = node->GetEnd();
+
+    for (; i != end; ++i)
+        if (ContainsArgument(*i, names)) return true;
+
+    return false;
+}
+
+void ExpandableNode::Unshare(opNode* node) {
+    iterator i = node->GetBegin();
+
+    while (i != node->GetEnd()) {
+        opNode* child = *i;
+
+        // shared nodes still have their own parents
+        if (child->GetParent() != node)
+            i = node->UnshareNode(i);
+        else {
+            Unshare(child);
+            ++i;
+        }
+    }
+}
+
 void ExpandableNode::ReplaceNodes(const opString& matchname, opNode* node) {
-    DoReplacement(this, matchname, node);
+    DoReplacement(this, opSymbol::Intern(matchname), node);
 }
 
 void ExpandableNode::ReplaceNodes(const opString& matchname, iterator start,
                                   iterator end) {
-    DoReplacement(this, matchname, start, end);
+    DoReplacement(this, opSymbol::Intern(matchname), start, end);
 }
 
 void ExpandableNode::CallOperators() {
@@ -32,7 +165,7 @@ void ExpandableNode::CallExpands() {
 }
 
 void ExpandableNode::DoReplacement(opNode* currentnode,
-                                   const opString& matchname, iterator instart,
+                                   const opSymbol& matchname, iterator instart,
                                    iterator inend) {
     iterator i = currentnode->GetBegin();
     iterator end = currentnode->GetEnd();
@@ -41,7 +174,7 @@ void ExpandableNode::DoReplacement(opNode* currentnode,
         opNode* currentChild = *i;
 
         if (currentChild->IsTerminal()) {
-            if (currentChild->GetStringValue() == matchname) {
+            if (((TerminalNode*)currentChild)->Is(matchname)) {
                 // delete the matched node
                 iterator newi = i;
                 ++i;
@@ -71,7 +204,7 @@ void ExpandableNode::DoReplacement(opNode* currentnode,
 }
 
 void ExpandableNode::DoReplacement(opNode* currentnode,
-                                   const opString& matchname,
+                                   const opSymbol& matchname,
                                    opNode* replacement) {
     iterator i = currentnode->GetBegin();
     iterator end = currentnode->GetEnd();
@@ -80,7 +213,7 @@ void ExpandableNode::DoReplacement(opNode* currentnode,
         opNode* currentChild = *i;
 
         if (TerminalNode* terminal = node_cast<TerminalNode>(currentChild)) {
-            if (terminal->GetValue() == matchname) {
+            if (terminal->Is(matchname)) {
                 // delete the matched node
                 iterator newi = i;
                 ++i;
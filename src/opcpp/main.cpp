@@ -90,6 +90,17 @@ int main(int argc, char** argv) {
         return 0;
     }
 
+    /*=== compile server ===*/
+
+    if (p.Server.GetUsed()) return opCompileServer::Run(p);
+
+    // forward to a compile server (compile here if there isn't one)
+    if (p.Connect.GetUsed()) {
+        int exitcode;
+
+        if (opCompileServer::Forward(p, exitcode)) return exitcode;
+    }
+
     /*=== initialize the driver and compile the code ===*/
 
     opDriver driver;
@@ -0,0 +1,307 @@
+///****************************************************************
+/// Copyright  2008 opGames LLC - All Rights Reserved
+///
+/// Authors: Kevin Depue & Lucas Ellis
+///
+/// File: Manifest.cpp
+/// Date: 10/17/2026
+///
+/// Description:
+///
+/// Build manifest source code.
+///****************************************************************
+
+#include "opcpp/opcpp.h"
+
+//
+// opBuildManifest
+//
+
+opMap<opString, opBuildManifest::Entry> opBuildManifest::Entries;
+opMap<opString, opString> opBuildManifest::Hashes;
+opSet<opString> opBuildManifest::Generated;
+bool opBuildManifest::bGenerated = false;
+opString opBuildManifest::FileName;
+opString opBuildManifest::Options;
+bool opBuildManifest::bOpen = false;
+bool opBuildManifest::bDirty = false;
+boost::mutex opBuildManifest::Mutex;
+
+namespace {
+
+opString ToHex(opBuildManifest::hashtype hash) {
+    char buffer[32];
+    sprintf(buffer, "%016llx", hash);
+    return buffer;
+}
+
+}  // namespace
+
+opString opBuildManifest::GetStamp() {
+    opString stamp = opVersion::GetVersionString() + " " + __DATE__ + " " +
+                     __TIME__;
+    stamp.Replace(' ', '_');
+    return stamp;
+}
+
+void opBuildManifest::Load(const opString& filename, const opString& options) {
+    Close();
+
+    FileName = filename;
+    Options = HashString(options);
+    bOpen = true;
+
+    std::ifstream ifs(filename.GetCString(), ios::in);
+
+    if (!ifs.is_open()) return;
+
+    opString file;
+    opArray<opString> lines;
+
+    file.LoadFile(ifs);
+    file.Tokenize('\n', lines);
+
+    int size = lines.Size();
+
+    // built by another compiler or with other options, start over
+    if (size < 2 || lines[0] != "stamp " + GetStamp() ||
+        lines[1] != "options " + Options) {
+        bDirty = true;
+        return;
+    }
+
+    Entry* entry = NULL;
+
+    for (int i = 2; i < size; i++) {
+        const opString& line = lines[i];
+
+        if (line == "globbed")
+            bGenerated = true;
+        else if (line.StartsWith("generated "))
+            Generated.Insert(line.Right(9));
+        else if (line.StartsWith("output "))
+            entry = &Entries[line.Right(6)];
+        else if (!entry)
+            continue;
+        else if (line.StartsWith("dialects "))
+            entry->Dialects = line.Right(8);
+        else if (line.StartsWith("input ")) {
+            // input <hash> <path>
+            opString rest = line.Right(5);
+            int space;
+
+            if (rest.Find(" ", space))
+                entry->Inputs.Insert(rest.Right(space), rest.Left(space));
+        }
+    }
+}
+
+void opBuildManifest::Save() {
+    if (bOpen && bDirty) {
+        FileWriteStream o(FileName);
+
+        if (o.is_open()) {
+            o << "stamp " << GetStamp() << endl;
+            o << "options " << Options << endl;
+
+            opMap<opString, Entry>::iterator it = Entries.Begin();
+            opMap<opString, Entry>::iterator end = Entries.End();
+
+            while (it != end) {
+                o << "output " << it->first << endl;
+
+                if (it->second.Dialects.Length())
+                    o << "dialects " << it->second.Dialects << endl;
+
+                opMap<opString, opString>::iterator iit =
+                    it->second.Inputs.Begin();
+                opMap<opString, opString>::iterator iend =
+                    it->second.Inputs.End();
+
+                while (iit != iend) {
+                    o << "input " << iit->second << " " << iit->first << endl;
+                    ++iit;
+                }
+
+                ++it;
+            }
+
+            if (bGenerated) {
+                o << "globbed" << endl;
+
+                opSet<opString>::iterator git = Generated.Begin();
+                opSet<opString>::iterator gend = Generated.End();
+
+                while (git != gend) {
+                    o << "generated " << *git << endl;
+                    ++git;
+                }
+            }
+        }
+    }
+
+    Close();
+}
+
+void opBuildManifest::Close() {
+    Entries.Clear();
+    Hashes.Clear();
+    Generated.Clear();
+    bGenerated = false;
+    FileName = "";
+    Options = "";
+    bOpen = false;
+    bDirty = false;
+}
+
+opString opBuildManifest::HashFile(const opString& filename) {
+    {
+        boost::mutex::scoped_lock lock(Mutex);
+
+        opString hash;
+
+        if (Hashes.Find(filename, hash)) return hash;
+    }
+
+    opString hash = "none";
+    FILE* file = fopen(filename.GetCString(), "rb");
+
+    if (file) {
+        char chunk[16384];
+        hashtype h = Hash(NULL, 0);
+        size_t count;
+
+        while ((count = fread(chunk, 1, sizeof(chunk), file)) > 0)
+            h = Hash(chunk, (int)count, h);
+
+        fclose(file);
+
+        hash = ToHex(h);
+    }
+
+    boost::mutex::scoped_lock lock(Mutex);
+
+    Hashes[filename] = hash;
+
+    return hash;
+}
+
+opString opBuildManifest::HashString(const opString& s) {
+    return ToHex(Hash(s.GetCString(), s.Length()));
+}
+
+opBuildManifest::Status opBuildManifest::Check(const opString& output,
+                                               const opString& dialects) {
+    opMap<opString, opString> inputs;
+    opString recorded;
+
+    {
+        boost::mutex::scoped_lock lock(Mutex);
+
+        if (!bOpen) return Changed;
+
+        opMap<opString, Entry>::iterator it = Entries.Find(output);
+
+        if (it == Entries.End()) return Changed;
+
+        inputs = it->second.Inputs;
+        recorded = it->second.Dialects;
+    }
+
+    opMap<opString, opString>::iterator it = inputs.Begin();
+    opMap<opString, opString>::iterator end = inputs.End();
+
+    while (it != end) {
+        if (HashFile(it->first) != it->second) return Changed;
+
+        ++it;
+    }
+
+    if (recorded != dialects) return DialectsChanged;
+
+    return Current;
+}
+
+void opBuildManifest::Record(const opString& output,
+                             const opSet<opString>& inputs,
+                             const opString& dialects) {
+    Entry entry;
+    entry.Dialects = dialects;
+
+    opSet<opString>::const_iterator it = inputs.Begin();
+    opSet<opString>::const_iterator end = inputs.End();
+
+    while (it != end) {
+        entry.Inputs.Insert(*it, HashFile(*it));
+        ++it;
+    }
+
+    boost::mutex::scoped_lock lock(Mutex);
+
+    if (!bOpen) return;
+
+    Entries[output] = entry;
+    bDirty = true;
+}
+
+void opBuildManifest::Forget(const opString& output) {
+    boost::mutex::scoped_lock lock(Mutex);
+
+    opMap<opString, Entry>::iterator it = Entries.Find(output);
+
+    if (it == Entries.End()) return;
+
+    Entries.Erase(it);
+    bDirty = true;
+}
+
+opString opBuildManifest::GetInputState(const opString& output) {
+    boost::mutex::scoped_lock lock(Mutex);
+
+    opString state;
+    opMap<opString, Entry>::iterator it = Entries.Find(output);
+
+    if (it == Entries.End()) return state;
+
+    opMap<opString, opString>::iterator iit = it->second.Inputs.Begin();
+    opMap<opString, opString>::iterator iend = it->second.Inputs.End();
+
+    while (iit != iend) {
+        state += iit->second + " " + iit->first + "\n";
+        ++iit;
+    }
+
+    return state;
+}
+
+bool opBuildManifest::GetGenerated(opSet<opString>& outputs) {
+    boost::mutex::scoped_lock lock(Mutex);
+
+    if (!bOpen || !bGenerated) return false;
+
+    outputs = Generated;
+
+    return true;
+}
+
+void opBuildManifest::SetGenerated(const opSet<opString>& outputs) {
+    boost::mutex::scoped_lock lock(Mutex);
+
+    if (!bOpen) return;
+
+    if (bGenerated && Generated == outputs) return;
+
+    Generated = outputs;
+    bGenerated = true;
+    bDirty = true;
+}
+
+void opBuildManifest::AddGenerated(const opString& output) {
+    boost::mutex::scoped_lock lock(Mutex);
+
+    // unknown until the globber walks the directory
+    if (!bOpen || !bGenerated || Generated.Contains(output)) return;
+
+    Generated.Insert(output);
+    bDirty = true;
+}
@@ -13,6 +13,103 @@
 
 #include "opcpp/opcpp.h"
 
+///==========================================
+/// opNodeArena
+///==========================================
+
+THREAD_LOCAL opNodeArena* opNodeArena::Current = NULL;
+
+opNodeArena::opNodeArena() : Next(NULL), End(NULL), Size(0) {
+    memset(Reuse, 0, sizeof(Reuse));
+}
+
+opNodeArena::~opNodeArena() {
+    opMemoryTracker::ArenaDeleted(this);
+
+    for (int i = 0; i < Chunks.Size(); i++) delete[] Chunks[i].Data;
+}
+
+void* opNodeArena::Allocate(size_t size) {
+    size = Align(size) + sizeof(Header);
+
+    // big blocks (long child arrays) are replaced as they grow, so they come
+    // from the heap where they can be reused
+    opNodeArena* arena = size <= MaxReused ? Current : NULL;
+
+    Header* header;
+
+    if (!arena)
+        header = (Header*)::operator new(size);
+    else if (arena->Reuse[size / Alignment]) {
+        void*& reuse = arena->Reuse[size / Alignment];
+
+        header = (Header*)reuse;
+        reuse = *(void**)reuse;
+    } else
+        header = (Header*)arena->Bump(size);
+
+    header->Arena = arena;
+
+    return header + 1;
+}
+
+void opNodeArena::Free(void* block, size_t size) {
+    if (!block) return;
+
+    Header* header = (Header*)block - 1;
+    opNodeArena* arena = header->Arena;
+    size = Align(size) + sizeof(Header);
+
+    if (!arena)
+        ::operator delete(header);
+    else if (arena == Current && size <= MaxReused) {
+        void*& reuse = arena->Reuse[size / Alignment];
+
+        *(void**)header = reuse;
+        reuse = header;
+    }
+}
+
+const char* opNodeArena::CopyText(const char* text, int length) {
+    if (!Current) return NULL;
+
+    char* copy = (char*)Current->Bump(Align(length + 1));
+    memcpy(copy, text, length);
+    copy[length] = '\0';
+
+    return copy;
+}
+
+bool opNodeArena::Contains(const void* block) const {
+    const char* p = (const char*)block;
+
+    for (int i = 0; i < Chunks.Size(); i++) {
+        if (p >= Chunks[i].Data && p < Chunks[i].Data + Chunks[i].Size)
+            return true;
+    }
+
+    return false;
+}
+
+void* opNodeArena::Bump(size_t size) {
+    if ((size_t)(End - Next) < size) {
+        Chunk chunk;
+        chunk.Size = size > ChunkSize ? size : ChunkSize;
+        chunk.Data = new char[chunk.Size];
+
+        Chunks.PushBack(chunk);
+        Size += chunk.Size;
+
+        Next = chunk.Data;
+        End = chunk.Data + chunk.Size;
+    }
+
+    void* block = Next;
+    Next += size;
+
+    return block;
+}
+
 #ifdef _DEBUG
 
 // memory tracker related from opnode
@@ -32,6 +129,48 @@ void opMemoryTracker::UnRegister(opNode* newnode) {
 
 opMemoryTracker::opMemoryTracker() { instance = this; }
 
+void opMemoryTracker::ArenaDeleted(const opNodeArena* arena) {
+    if (!instance) return;
+
+    opArray<opNode*> leaked;
+
+    opSet<opNode*>::iterator end = instance->TrackedNodes.End();
+
+    for (opSet<opNode*>::iterator it = instance->TrackedNodes.Begin();
+         it != end; ++it) {
+        if (arena->Contains(*it)) leaked.PushBack(*it);
+    }
+
+    for (int i = 0; i < leaked.Size(); i++) {
+        ReportLeak(leaked[i]);
+        instance->TrackedNodes.Erase(leaked[i]);
+    }
+}
+
+void opMemoryTracker::ReportLeak(opNode* node) {
+    opString classname = node->GetNodeType();
+    opString location = node->GetAllocationLocation();
+
+    // we want to debug before it's created
+    int number = node->GetAllocationNumber();
+
+    opNode* parent = node->GetParent();
+    opString parentvalid = parent ? instance->TrackedNodes.Contains(parent)
+                                        ? "parent exists"
+                                        : "parent deleted!"
+                                  : "parent NULL";
+
+    Log(opString(location + " : error : leaked \"") + classname +
+        "\", debug before allocation with DebugAllocationNumber(" + number +
+        "); " + parentvalid);
+
+    if (node->GetFile()) {
+        opString tokenlocation =
+            node->GetFile()->GetInputName() + "(" + node->GetLine() + ")";
+        Log(opString(tokenlocation + " : original location"));
+    }
+}
+
 opMemoryTracker::~opMemoryTracker() {
     // unregister all reachable nodes
     FileNode::UnRegisterLoadedFiles();
@@ -41,30 +180,8 @@ opMemoryTracker::~opMemoryTracker() {
     opSet<opNode*>::iterator begin = TrackedNodes.Begin();
     opSet<opNode*>::iterator end = TrackedNodes.End();
 
-    for (opSet<opNode*>::iterator it = begin; it != end; ++it) {
-        opNode* node = (*it);
-        opString classname = node->GetNodeType();
-        opString location = node->GetAllocationLocation();
-
-        // we want to debug before it's created
-        int number = node->GetAllocationNumber();
-
-        opNode* parent = node->GetParent();
-        opString parentvalid = parent ? TrackedNodes.Contains(parent)
-                                            ? "parent exists"
-                                            : "parent deleted!"
-                                      : "parent NULL";
-
-        Log(opString(location + " : error : leaked \"") + classname +
-            "\", debug before allocation with DebugAllocationNumber(" + number +
-            "); " + parentvalid);
-
-        if (node->GetFile()) {
-            opString tokenlocation =
-                node->GetFile()->GetInputName() + "(" + node->GetLine() + ")";
-            Log(opString(tokenlocation + " : original location"));
-        }
-    }
+    for (opSet<opNode*>::iterator it = begin; it != end; ++it)
+        ReportLeak(*it);
 
     TrackedNodes.Clear();
 
@@ -31,14 +31,14 @@ bool ModifiersBase::HasModifier(Token tok) {
     return false;
 }
 
-// has a basic modifier? by string
-bool ModifiersBase::HasModifier(const opString& modifiername) {
+// has a basic modifier? by name
+bool ModifiersBase::HasModifier(const opSymbol& modifiername) {
     iterator i = GetBegin();
     iterator end = GetEnd();
 
     while (i != end) {
         if (TerminalNode* node = node_cast<TerminalNode>(*i)) {
-            if (node->GetValue() == modifiername) return true;
+            if (node->Is(modifiername)) return true;
         }
 
         ++i;
@@ -0,0 +1,223 @@
+///****************************************************************
+/// Copyright  2008 opGames LLC - All Rights Reserved
+///
+/// Authors: Kevin Depue & Lucas Ellis
+///
+/// File: opNodeList.cpp
+/// Date: 10/17/2026
+///
+/// Description:
+///
+/// Child storage for opNodes.
+///****************************************************************
+
+#include "opcpp/opcpp.h"
+
+namespace nodes {
+
+///
+/// opNodeList
+///
+
+opNodeList::Block opNodeList::Empty = {0, 0, 0, false, 0, NULL, {NULL}};
+
+opNodeList::iterator opNodeList::Find(opNode* node) {
+    Block* items = Items;
+
+    for (int i = 0; i < items->GapStart; i++)
+        if (items->Slots[i] == node) return iterator(this, i + 1, node);
+
+    for (int i = items->GapEnd; i < items->Capacity; i++)
+        if (items->Slots[i] == node)
+            return iterator(this, i - items->Capacity, node);
+
+    return End();
+}
+
+void opNodeList::Insert(const iterator& before, opNode* node) {
+    MoveGap(IndexOf(before));
+    Reserve(1);
+
+    Items->Slots[Items->GapStart++] = node;
+}
+
+opNodeList::iterator opNodeList::Erase(const iterator& position) {
+    assert(position.Node);
+
+    int index = IndexOf(position);
+
+    MoveGap(index);
+    Items->GapEnd++;
+
+    iterator next = At(index);
+
+    if (position.Node == Items->Position) SetPosition(next);
+
+    return next;
+}
+
+void opNodeList::Clear() {
+    Release();
+
+    Items = &Empty;
+}
+
+void opNodeList::Splice(const iterator& before, opNodeList& from,
+                        const iterator& first, const iterator& last) {
+    assert(&from != this);
+
+    int start = from.IndexOf(first);
+    int count = from.IndexOf(last) - start;
+
+    if (count <= 0) return;
+
+    int position =
+        from.Items->Position ? from.IndexOf(from.GetPosition()) : -1;
+
+    MoveGap(IndexOf(before));
+    Reserve(count);
+
+    // the range starts the other list's tail once its gap is before it
+    from.MoveGap(start);
+
+    memcpy(Items->Slots + Items->GapStart,
+           from.Items->Slots + from.Items->GapEnd, count * sizeof(opNode*));
+
+    Items->GapStart += count;
+    from.Items->GapEnd += count;
+
+    // a position in the moved range stays in the other list, after it
+    if (position >= start && position < start + count)
+        from.SetPosition(from.At(start));
+}
+
+void opNodeList::Step(iterator& it, int offset) {
+    if (it.Node) {
+        opNodeList* list = ListOf(it.Node);
+
+        // spliced away, unless this list shares it
+        if (list && list != this && (!Items->bShared || Search(it) < 0)) {
+            it.List = list;
+            list->Step(it, offset);
+            return;
+        }
+    }
+
+    it = At(IndexOf(it) + offset);
+}
+
+opNodeList* opNodeList::ListOf(opNode* node) {
+    opNode* parent = node->GetParent();
+
+    return parent ? &parent->children : NULL;
+}
+
+int opNodeList::Search(const iterator& it) {
+    int size = Size();
+
+    if (!size) return -1;
+
+    // start from the index it had, which is still right if only the gap
+    // has moved since
+    int guess = it.Index > 0 ? it.Index - 1 : size + it.Index;
+
+    if (guess < 0) guess = 0;
+    if (guess >= size) guess = size - 1;
+
+    opNode** slots = Items->Slots;
+
+    for (int distance = 0; distance < size; distance++) {
+        int below = guess - distance;
+        int above = guess + distance;
+
+        if (below >= 0 && slots[SlotOf(below)] == it.Node) {
+            it.Index = Encode(SlotOf(below));
+            return below;
+        }
+
+        if (above < size && slots[SlotOf(above)] == it.Node) {
+            it.Index = Encode(SlotOf(above));
+            return above;
+        }
+    }
+
+    return -1;
+}
+
+int opNodeList::Relocate(const iterator& it) {
+    int index = Search(it);
+
+    // not in this list (erased, or spliced away and used with this list)
+    assert(index >= 0);
+
+    return index < 0 ? Size() : index;
+}
+
+void opNodeList::MoveGap(int index) {
+    Block* items = Items;
+
+    if (index == items->GapStart) return;
+
+    int position = items->Position ? IndexOf(GetPosition()) : -1;
+    opNode** slots = items->Slots;
+
+    if (index < items->GapStart) {
+        int count = items->GapStart - index;
+
+        memmove(slots + items->GapEnd - count, slots + index,
+                count * sizeof(opNode*));
+
+        items->GapStart -= count;
+        items->GapEnd -= count;
+    } else {
+        int count = index - items->GapStart;
+
+        memmove(slots + items->GapStart, slots + items->GapEnd,
+                count * sizeof(opNode*));
+
+        items->GapStart += count;
+        items->GapEnd += count;
+    }
+
+    if (items->Position) items->PositionIndex = Encode(SlotOf(position));
+}
+
+void opNodeList::Reserve(int count) {
+    Block* items = Items;
+
+    if (items->GapEnd - items->GapStart >= count) return;
+
+    int capacity = items->Capacity ? items->Capacity * 2 : 4;
+
+    while (capacity - Size() < count) capacity *= 2;
+
+    Block* grown = (Block*)opNodeArena::Allocate(
+        sizeof(Block) + (capacity - 1) * sizeof(opNode*));
+    int tail = items->Capacity - items->GapEnd;
+
+    memcpy(grown->Slots, items->Slots, items->GapStart * sizeof(opNode*));
+    memcpy(grown->Slots + capacity - tail, items->Slots + items->GapEnd,
+           tail * sizeof(opNode*));
+
+    // (tail indexes count back from the capacity, so the position's index
+    // doesn't change)
+    grown->GapStart = items->GapStart;
+    grown->GapEnd = capacity - tail;
+    grown->Capacity = capacity;
+    grown->bShared = items->bShared;
+    grown->PositionIndex = items->PositionIndex;
+    grown->Position = items->Position;
+
+    Release();
+
+    Items = grown;
+}
+
+void opNodeList::Release() {
+    if (Items == &Empty) return;
+
+    opNodeArena::Free(Items,
+                      sizeof(Block) + (Items->Capacity - 1) * sizeof(opNode*));
+}
+
+}  // end namespace nodes
@@ -59,6 +59,12 @@ OPCOMPILING_SOURCE("opcpp/stream.cpp");
 OPCOMPILING_SOURCE("opcpp/node.cpp");
 #include "opcpp/node.cpp"
 
+OPCOMPILING_SOURCE("opcpp/node_list.cpp");
+#include "opcpp/node_list.cpp"
+
+OPCOMPILING_SOURCE("opcpp/symbol_table.cpp");
+#include "opcpp/symbol_table.cpp"
+
 OPCOMPILING_SOURCE("opcpp/symbol_tracker.cpp");
 #include "opcpp/symbol_tracker.cpp"
 
@@ -107,9 +113,21 @@ OPCOMPILING_SOURCE("opcpp/macro_nodes.cpp")
 OPCOMPILING_SOURCE("opcpp/scanner.cpp");
 #include "opcpp/scanner.cpp"
 
+OPCOMPILING_SOURCE("opcpp/manifest.cpp");
+#include "opcpp/manifest.cpp"
+
+OPCOMPILING_SOURCE("opcpp/dialect_cache.cpp");
+#include "opcpp/dialect_cache.cpp"
+
+OPCOMPILING_SOURCE("opcpp/path_cache.cpp");
+#include "opcpp/path_cache.cpp"
+
 OPCOMPILING_SOURCE("opcpp/timer.cpp");
 #include "opcpp/timer.cpp"
 
+OPCOMPILING_SOURCE("opcpp/benchmark.cpp");
+#include "opcpp/benchmark.cpp"
+
 OPCOMPILING_SOURCE("opcpp/dialect_nodes.cpp");
 #include "opcpp/dialect_nodes.cpp"
 
@@ -119,6 +137,9 @@ OPCOMPILING_SOURCE("opcpp/print_dialect.cpp");
 OPCOMPILING_SOURCE("opcpp/globber.cpp")
 #include "opcpp/globber.cpp"
 
+OPCOMPILING_SOURCE("opcpp/server.cpp");
+#include "opcpp/server.cpp"
+
 OPCOMPILING_SOURCE("opcpp/memory_tracker.cpp")
 #include "opcpp/memory_tracker.cpp"
 
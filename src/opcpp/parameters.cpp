@@ -67,9 +67,12 @@ opIntOption::opIntOption(const opString& name, const opString& description,
 
 vector<opOption*> opParameters::Options;
 opParameters* opParameters::Instance = NULL;
+THREAD_LOCAL opParameters* opParameters::JobInstance = NULL;
 
 // Returns writable reference.
 opParameters& opParameters::GetWritable() {
+    if (JobInstance) return *JobInstance;
+
     if (Instance == NULL) Instance = new opParameters();
 
     return *Instance;
@@ -77,6 +80,8 @@ opParameters& opParameters::GetWritable() {
 
 // Returns non-writable reference.
 const opParameters& opParameters::Get() {
+    if (JobInstance) return *JobInstance;
+
     if (Instance == NULL) Instance = new opParameters();
 
     return *Instance;
@@ -85,6 +90,10 @@ const opParameters& opParameters::Get() {
 // destroy the instance
 void opParameters::Destroy() {
     if (Instance) delete Instance;
+
+    // a new instance registers its own options
+    Instance = NULL;
+    Options.clear();
 }
 
 // Constructor.
@@ -204,6 +213,13 @@ opParameters::opParameters()
                "The compiler will generate an xml representation of your opC++ "
                "code."),
 
+      // Depfiles
+      Depfiles("depfiles",
+               "Writes a Makefile syntax dependency file (.d) next to each "
+               "generated file pair,"
+               "\n\tlisting the source, its opincluded files and the "
+               "dialects it uses."),
+
       // NoStandardIncludes
       NoStandardIncludes(
           "nostandardincludes",
@@ -217,6 +233,42 @@ opParameters::opParameters()
       // FixedSys
       FixedSys("fixedsys", "Fixes problems with fixedsys font output."),
 
+      // Jobs
+      Jobs("jobs",
+           "Number of code (.oh) files to compile in parallel.  The default "
+           "is 1, 0 uses"
+           "\n\tone job per hardware thread.",
+           false, 1),
+
+      // Server
+      Server("server",
+             "Runs a compile server that keeps dialects loaded between "
+             "requests.  Requests are read"
+             "\n\tfrom the given local socket, or from the standard in if the "
+             "socket is '-'.",
+             false, ""),
+
+      // Connect
+      Connect("connect",
+              "Forwards the command line to the compile server listening on "
+              "the given local socket.",
+              false, ""),
+
+      // GlobShards
+      GlobShards("globshards",
+                 "Splits the generated source index into this many shards "
+                 "that can be compiled"
+                 "\n\tseparately.  Generated.ocppindex then includes every "
+                 "shard.",
+                 false, 0),
+
+      // Trace
+      Trace("trace",
+            "Records how long each compiler phase takes and saves it to the "
+            "given file in"
+            "\n\tchrome trace format (chrome://tracing or Perfetto).",
+            false, ""),
+
       /*=== debug options (these options are hidden) ===*/
 
       // PrintTree (hidden)
@@ -236,6 +288,20 @@ opParameters::opParameters()
                     "developers.",
                     true),
 
+      // Benchmark (hidden)
+      Benchmark("benchmark",
+                "Recompiles every code file and reports its throughput as "
+                "json.  The mode is"
+                "\n\tscan, parse or emit (only emit writes output).",
+                true, ""),
+
+      // DispatchParse (hidden)
+      DispatchParse("dispatchparse",
+                    "Parses opobject bodies with the token dispatched "
+                    "recognizer, which skips the passes"
+                    "\n\tthat can't find anything (experimental).",
+                    true),
+
       /*=== other ===*/
 
       NormalMode(false) {}
@@ -353,7 +419,8 @@ bool opParameters::Parse() {
     // use of "-ohd" implies NormalMode = true
     if (FileDirectories.GetUsed()) NormalMode = true;
 
-    if (!NormalMode && !GlobMode && !CleanMode && !Version) {
+    if (!NormalMode && !GlobMode && !CleanMode && !Version &&
+        !Server.GetUsed()) {
         Log("Error: No Valid Processing Mode Specified.");
         PrintSyntax();
         return false;
@@ -365,6 +432,14 @@ bool opParameters::Parse() {
     // "-nodebug" takes effect
     if (NoDebug) opStringStream::SetLineDirectives(false);
 
+    if (!opBenchmark::SetMode(Benchmark.GetValue())) {
+        Log("Error: Benchmark mode must be scan, parse or emit.");
+        return false;
+    }
+
+    // every file is measured, not just the changed ones
+    if (Benchmark.GetValue() != "") Force = true;
+
     // here we want to add the opCpp Include directory to -d
     // NOTE: happens before dialects are read in.
     if (!NoStandardIncludes) {
@@ -413,9 +488,26 @@ bool opParameters::Validate() {
         PrintTree = false;
     }
 
+    if (Jobs.GetValue() < 0) {
+        Log("Warning: Invalid number of jobs, compiling with 1 job.");
+        Log("");
+
+        Jobs = 1;
+    }
+
+    if (GlobShards.GetValue() < 0) {
+        Log("Warning: Invalid number of glob shards, writing one index.");
+        Log("");
+
+        GlobShards = 0;
+    }
+
 // Developer mode should always be enabled in debug.
 #ifdef _DEBUG
     DeveloperMode = true;
+
+    // the memory tracker isn't thread safe
+    Jobs = 1;
 #endif
 
     return true;
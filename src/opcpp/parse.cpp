@@ -24,9 +24,7 @@ bool FileNode::Preprocessor() {
 
         if (!CheckBlockCorrectness()) return false;
 
-        FindBraces();
-        FindParentheses();
-        FindBrackets();
+        FindBlocks();
 
         ProcessChildNodes();
     }
@@ -108,6 +106,66 @@ bool FileNode::CheckBlockCorrectness() {
     return false;
 }
 
+// groups every (), [] and {} in one pass: when a right closes the innermost
+// left, the nodes between them (whose own blocks are already grouped) move
+// into a block that replaces the pair.  This nests them the way FindBraces,
+// FindParentheses and FindBrackets do a level at a time, but moves each
+// node once.  Call after CheckBlockCorrectness, it assumes they balance.
+void FileNode::FindBlocks() {
+    // the open lefts, innermost last
+    vector<iterator> lefts;
+
+    iterator i = GetBegin();
+    iterator end = GetEnd();
+
+    while (i != end) {
+        Token id = i->GetId();
+
+        if (!i->IsTerminal() || !IsBlock(id)) {
+            ++i;
+            continue;
+        }
+
+        if (IsLeftBlock(id)) {
+            lefts.push_back(i);
+            ++i;
+            continue;
+        }
+
+        iterator left = lefts.back();
+        iterator right = i;
+
+        lefts.pop_back();
+        ++i;
+
+        if (id == T_RIGHT_BRACE)
+            CollapseBlock<BraceBlockNode>(left, right);
+        else if (id == T_RIGHT_PAREN)
+            CollapseBlock<ParenBlockNode>(left, right);
+        else
+            CollapseBlock<BracketBlockNode>(left, right);
+    }
+
+    ResetPosition();
+}
+
+// replaces [left,right] with a block holding what's between them
+template <class T>
+void FileNode::CollapseBlock(iterator left, iterator right) {
+    stacked<T> block = NEWNODE(T());
+
+    block->CopyBasics(*left);
+
+    iterator first = left;
+    ++first;
+
+    block->MoveNodes(block->GetEnd(), this, first, right);
+
+    InsertNode(block, left);
+    DeleteNode(left);
+    DeleteNode(right);
+}
+
 //
 // BraceBlockNode
 //
@@ -0,0 +1,109 @@
+///****************************************************************
+/// Copyright  2008 opGames LLC - All Rights Reserved
+///
+/// Authors: Kevin Depue & Lucas Ellis
+///
+/// File: PathCache.cpp
+/// Date: 10/17/2026
+///
+/// Description:
+///
+/// Path cache source code.
+///****************************************************************
+
+#include "opcpp/opcpp.h"
+
+//
+// opPathCache
+//
+
+opMap<opString, opPathCache::Entry> opPathCache::Entries;
+opMap<opString, opString> opPathCache::Includes;
+boost::mutex opPathCache::Mutex;
+int opPathCache::Stats = 0;
+int opPathCache::StatHits = 0;
+int opPathCache::IncludeLookups = 0;
+int opPathCache::IncludeHits = 0;
+
+void opPathCache::Reset() {
+    boost::mutex::scoped_lock lock(Mutex);
+
+    Entries.Clear();
+    Includes.Clear();
+
+    Stats = 0;
+    StatHits = 0;
+    IncludeLookups = 0;
+    IncludeHits = 0;
+}
+
+opPathCache::Entry opPathCache::Stat(const path& p, bool btime) {
+    opString key = p.string();
+    Entry entry;
+
+    {
+        boost::mutex::scoped_lock lock(Mutex);
+
+        opMap<opString, Entry>::iterator it = Entries.Find(key);
+
+        if (it != Entries.End()) {
+            entry = it->second;
+
+            if (!btime || entry.bTime || !entry.bExists) {
+                StatHits++;
+                return entry;
+            }
+        }
+    }
+
+    // not cached (or cached without a time)
+    entry.bExists = exists(p);
+
+    if (btime && entry.bExists) {
+        entry.Time = last_write_time(p);
+        entry.bTime = true;
+    }
+
+    boost::mutex::scoped_lock lock(Mutex);
+
+    Stats++;
+    Entries[key] = entry;
+
+    return entry;
+}
+
+bool opPathCache::Exists(const path& p) { return Stat(p, false).bExists; }
+
+time_t opPathCache::LastWriteTime(const path& p) {
+    return Stat(p, true).Time;
+}
+
+bool opPathCache::FindInclude(const opString& directory,
+                              const opString& include, opString& resolved) {
+    boost::mutex::scoped_lock lock(Mutex);
+
+    IncludeLookups++;
+
+    if (!Includes.Find(directory + "|" + include, resolved)) return false;
+
+    IncludeHits++;
+
+    return true;
+}
+
+void opPathCache::StoreInclude(const opString& directory,
+                               const opString& include,
+                               const opString& resolved) {
+    boost::mutex::scoped_lock lock(Mutex);
+
+    Includes[directory + "|" + include] = resolved;
+}
+
+void opPathCache::LogCounters() {
+    boost::mutex::scoped_lock lock(Mutex);
+
+    Log(opString("Path cache: ") + Stats + " stats, " + StatHits +
+        " cached, " + IncludeLookups + " opinclude lookups, " + IncludeHits +
+        " cached");
+    Log("");
+}
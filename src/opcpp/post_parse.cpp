@@ -18,6 +18,9 @@ bool OPFileNode::PostParse() {
 }
 
 bool OPObjectNode::PostParse() {
+    opTraceScope trace;
+    if (opTrace::IsEnabled()) trace.Begin(ErrorName(), "object");
+
     // TODO: need to iterate over all statements in the body
     // we need to keep track of the visibility labels,
     // and notify the statements about their visibility
@@ -38,6 +41,9 @@ bool OPObjectNode::PostParse() {
 }
 
 bool OPEnumNode::PostParse() {
+    opTraceScope trace;
+    if (opTrace::IsEnabled()) trace.Begin(ErrorName(), "object");
+
     POSTPARSE_START;
     { RegisterAutoModifiers(); }
     POSTPARSE_END;
@@ -151,6 +151,18 @@ opString ExpandCallNode::GetSignature() {
     return sig;
 }
 
+opMacroSignature ExpandCallNode::GetKey() {
+    int arguments = Arguments ? (int)Arguments->GetArguments().size() : -1;
+
+    if (TerminalNode* terminal = node_cast<TerminalNode>(Name))
+        return opMacroSignature(terminal->GetSymbol(), arguments);
+
+    opString name;
+    Name->PrintString(name);
+
+    return opMacroSignature(opSymbol::Intern(name), arguments);
+}
+
 bool ExpandCallNode::Expand(opSymbolTracker& tracker, opNode::iterator expandit,
                             opNode* parent) {
     // TODO: reimplement expansion depth checking
@@ -161,9 +173,7 @@ bool ExpandCallNode::Expand(opSymbolTracker& tracker, opNode::iterator expandit,
     // need to have the arguments parsed
     if (Arguments) Arguments->PreProcess();
 
-    opString signature = GetSignature();
-
-    if (OPMacroNode* macro = tracker.OPMacroRegistered(signature)) {
+    if (OPMacroNode* macro = tracker.OPMacroRegistered(GetKey())) {
         stacked<OPMacroBodyNode> cloned = macro->GetBody()->Clone();
         opNode* parentNode = GetParent();
 
@@ -223,7 +233,7 @@ bool ExpandCallNode::Expand(opSymbolTracker& tracker, opNode::iterator expandit,
         ExpansionDepth--;
     } else {
         // TODO: this could be much improved
-        opError::ExpandError(this, signature, tracker);
+        opError::ExpandError(this, GetSignature(), tracker);
     }
 
     OPERATIONS_END;
@@ -280,3 +290,9 @@ opString OPMacroNode::GetSignature() {
 
     return sig;
 }
+
+opMacroSignature OPMacroNode::GetKey() {
+    int arguments = Arguments ? (int)Arguments->GetArguments().size() : -1;
+
+    return opMacroSignature(GetName()->GetSymbol(), arguments);
+}
@@ -925,6 +925,9 @@ void FunctionDefinitionNode::PrintOriginal(opSectionStream& stream) {
 //
 
 void OPEnumNode::PrintNode(opFileStream& stream) {
+    opTraceScope trace;
+    if (opTrace::IsEnabled()) trace.Begin(ErrorName(), "object");
+
     DialectEnumeration* enumsettings = GetEnumSettings();
 
     // print the enum identifier note
@@ -1058,6 +1061,9 @@ void OPObjectNode::PrintInheritance(opSectionStream& stream) {
 }
 
 void OPObjectNode::PrintNode(opFileStream& stream) {
+    opTraceScope trace;
+    if (opTrace::IsEnabled()) trace.Begin(ErrorName(), "object");
+
     if (opParameters::Get().Notations || opParameters::Get().PrintXml) {
         FetchAllModifiers();
 
@@ -125,16 +125,16 @@ void OPTypeBase::PrintNote(DialectNote& note, opSectionStream& stream,
     // NOTE: should I print something on skip?
     if (notenode->IsBodyEmpty()) return;
 
+    opTraceScope trace;
+    if (opTrace::IsEnabled()) trace.Begin("Note " + note.GetName(), "note");
+
     // get the argument names from the note definition
     vector<opString> argumentnames;
     notenode->GetArguments(argumentnames);
 
     stream << endl;
 
-    // TODO: create clone for replacement
-    stacked<BraceBlockNode> clonebody = notenode->GetBody()->Clone();
-    stacked<ExpandableNode> clonenode =
-        opNode::Transform<ExpandableNode>(clonebody);
+    vector<opNode*> argumentvalues;
 
     stackedgroup tempmodifiers;
 
@@ -175,10 +175,13 @@ void OPTypeBase::PrintNote(DialectNote& note, opSectionStream& stream,
                 stream << "\"" << endl;
             }
 
-            clonenode->ReplaceNodes(argumentname, argumentvalue);
+            argumentvalues.push_back(argumentvalue);
         }
     }
 
+    stacked<ExpandableNode> clonenode = ExpandableNode::Expand(
+        notenode->GetBody(), argumentnames, argumentvalues);
+
     // now we need to do recursive macro replacement
     //	MacroOperationWalker runOperations(*clonenode);
 
@@ -478,9 +481,7 @@ void OPEnumNode::PrintEnumMapping(opSectionStream& stream,
     vector<opString> argumentnames;
     notenode.GetArguments(argumentnames);
 
-    stacked<BraceBlockNode> clonebody = notenode.GetBody()->Clone();
-    stacked<ExpandableNode> clonenode =
-        opNode::Transform<ExpandableNode>(clonebody);
+    vector<opNode*> argumentvalues;
 
     stackedgroup temparguments;
 
@@ -520,10 +521,13 @@ void OPEnumNode::PrintEnumMapping(opSectionStream& stream,
                 stream << "\"" << endl;
             }
 
-            clonenode->ReplaceNodes(argumentname, argumentvalue);
+            argumentvalues.push_back(argumentvalue);
         }
     }
 
+    stacked<ExpandableNode> clonenode = ExpandableNode::Expand(
+        notenode.GetBody(), argumentnames, argumentvalues);
+
     // perform operations
     //	MacroOperationWalker operations(*clonenode);
 
@@ -702,9 +706,7 @@ void OPObjectNode::PrintDataMapping(opSectionStream& stream,
     vector<opString> argumentnames;
     notenode.GetArguments(argumentnames);
 
-    stacked<BraceBlockNode> clonebody = notenode.GetBody()->Clone();
-    stacked<ExpandableNode> clonenode =
-        opNode::Transform<ExpandableNode>(clonebody);
+    vector<opNode*> argumentvalues;
 
     stackedgroup temparguments;
 
@@ -747,10 +749,13 @@ void OPObjectNode::PrintDataMapping(opSectionStream& stream,
                 stream << "\"" << endl;
             }
 
-            clonenode->ReplaceNodes(argumentname, argumentvalue);
+            argumentvalues.push_back(argumentvalue);
         }
     }
 
+    stacked<ExpandableNode> clonenode = ExpandableNode::Expand(
+        notenode.GetBody(), argumentnames, argumentvalues);
+
     // perform operations
     //	MacroOperationWalker operations(*clonenode);
 
@@ -927,9 +932,7 @@ void OPObjectNode::PrintFunctionMapping(opSectionStream& stream,
     vector<opString> argumentnames;
     notenode.GetArguments(argumentnames);
 
-    stacked<BraceBlockNode> clonebody = notenode.GetBody()->Clone();
-    stacked<ExpandableNode> clonenode =
-        opNode::Transform<ExpandableNode>(clonebody);
+    vector<opNode*> argumentvalues;
 
     stackedgroup temparguments;
 
@@ -967,10 +970,13 @@ void OPObjectNode::PrintFunctionMapping(opSectionStream& stream,
                 stream << "\"" << endl;
             }
 
-            clonenode->ReplaceNodes(argumentname, argumentvalue);
+            argumentvalues.push_back(argumentvalue);
         }
     }
 
+    stacked<ExpandableNode> clonenode = ExpandableNode::Expand(
+        notenode.GetBody(), argumentnames, argumentvalues);
+
     // perform operations
     //	MacroOperationWalker operations(*clonenode);
 
@@ -17,18 +17,786 @@
 // opScanner
 //
 
+// character types (see opScanner::CharType)
+const unsigned char opScanner::CharTypes[256] = {
+    // 0x00
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x02, 0x01, 0x00, 0x00, 0x01, 0x00, 0x00,
+    // 0x10
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 0x20
+    0x02, 0x20, 0x40, 0x20, 0x00, 0x20, 0x20, 0x40,
+    0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
+    // 0x30
+    0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14,
+    0x14, 0x14, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
+    // 0x40
+    0x00, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    // 0x50
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x20, 0x20, 0x20, 0x20, 0x80,
+    // 0x60
+    0x20, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    // 0x70
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x20, 0x20, 0x20, 0x20, 0x00,
+    // 0x80 - 0xff
+};
+
+opPerfectHash<int> opScanner::Words;
+
+void opScanner::InitWords() {
+    static const char* preprocessor[] = {
+        "define", "elif", "else", "endif", "error", "if", "ifdef", "ifndef",
+        "import", "include", "line", "pragma", "undef", "using", "warning"};
+
+    static const char* standardbasic[] = {
+        "char", "bool", "short", "long", "float", "double", "wchar_t",
+        "int", "void", "long long", "long double"};
+
+    static const char* microsoftbasic[] = {"__wchar_t", "__int8", "__int16",
+                                           "__int32", "__int64"};
+
+    static const char* signable[] = {"char",   "short",   "long",    "int",
+                                     "__int8", "__int16", "__int32", "__int64"};
+
+    static const char* suffixes[] = {
+        "u",    "l",    "U",    "L",    "ul",   "lu",   "UL",   "LU",
+        "uL",   "Ul",   "lU",   "Lu",   "LL",   "ll",   "ull",  "uLL",
+        "Ull",  "ULL",  "i8",   "I8",   "ui8",  "uI8",  "Ui8",  "UI8",
+        "i16",  "I16",  "ui16", "uI16", "Ui16", "UI16", "i32",  "I32",
+        "ui32", "uI32", "Ui32", "UI32", "i64",  "I64",  "ui64", "uI64",
+        "Ui64", "UI64"};
+
+    struct {
+        const char** words;
+        int count;
+        int wordclass;
+    } lists[] = {
+        {preprocessor, sizeof(preprocessor) / sizeof(char*), WC_PREPROCESSOR},
+        {standardbasic, sizeof(standardbasic) / sizeof(char*),
+         WC_STANDARD_BASIC_TYPE},
+        {microsoftbasic, sizeof(microsoftbasic) / sizeof(char*),
+         WC_MICROSOFT_BASIC_TYPE},
+        {signable, sizeof(signable) / sizeof(char*), WC_SIGNABLE},
+        {suffixes, sizeof(suffixes) / sizeof(char*), WC_INTEGER_SUFFIX},
+    };
+
+    // a word can be in more than one list
+    opMap<opString, int> classes;
+
+    for (int i = 0; i < (int)(sizeof(lists) / sizeof(lists[0])); i++) {
+        for (int j = 0; j < lists[i].count; j++)
+            classes[lists[i].words[j]] |= lists[i].wordclass;
+    }
+
+    opMap<opString, int>::iterator end = classes.End();
+
+    for (opMap<opString, int>::iterator it = classes.Begin(); it != end; ++it)
+        Words.Insert(it->first, it->second);
+
+    // the words are fixed, so a failure is a bug (not an input error)
+    if (!Words.Build()) {
+        Log("error: couldn't build the scanner word lookup");
+        assert(0);
+        abort();
+    }
+}
+
+#ifdef SCANNER_SSE2
+
+namespace {
+
+// marks the bytes in [lo, hi]
+inline __m128i ScannerInRange(__m128i bytes, char lo, char hi) {
+    __m128i offset = _mm_sub_epi8(bytes, _mm_set1_epi8(lo));
+
+    return _mm_cmpeq_epi8(_mm_min_epu8(offset, _mm_set1_epi8(hi - lo)),
+                          offset);
+}
+
+inline int ScannerFirstBit(int mask) {
+#ifdef PLATFORM_WINDOWS
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return (int)index;
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+}  // namespace
+
+#endif
+
+size_t opScanner::SkipWhiteSpace(char* text, size_t index, size_t end) {
+#ifdef SCANNER_SSE2
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i tab = _mm_set1_epi8('\t');
+
+    while (index + 16 <= end) {
+        __m128i bytes = _mm_loadu_si128((const __m128i*)(text + index));
+        __m128i match = _mm_or_si128(_mm_cmpeq_epi8(bytes, space),
+                                     _mm_cmpeq_epi8(bytes, tab));
+        int mask = ~_mm_movemask_epi8(match) & 0xffff;
+
+        // the end of the run still needs the "\r\n" check below
+        if (mask) {
+            index += ScannerFirstBit(mask);
+            break;
+        }
+
+        index += 16;
+    }
+#endif
+
+    while (index < end && IsWhiteSpace(text[index])) ++index;
+
+    // a run before "\r\n" ends at the '\n'
+    if (index < end && SpaceCR(text, index, end)) ++index;
+
+    return index;
+}
+
+size_t opScanner::SkipIdChars(const char* text, size_t index, size_t end) {
+#ifdef SCANNER_SSE2
+    const __m128i underscore = _mm_set1_epi8('_');
+
+    while (index + 16 <= end) {
+        __m128i bytes = _mm_loadu_si128((const __m128i*)(text + index));
+        __m128i match = _mm_or_si128(
+            _mm_or_si128(ScannerInRange(bytes, 'a', 'z'),
+                         ScannerInRange(bytes, 'A', 'Z')),
+            _mm_or_si128(ScannerInRange(bytes, '0', '9'),
+                         _mm_cmpeq_epi8(bytes, underscore)));
+        int mask = ~_mm_movemask_epi8(match) & 0xffff;
+
+        if (mask) return index + ScannerFirstBit(mask);
+
+        index += 16;
+    }
+#endif
+
+    while (index < end && IsIdChar(text[index])) ++index;
+
+    return index;
+}
+
+size_t opScanner::FindAny(const char* text, size_t index, size_t end, char a,
+                          char b, char c) {
+#ifdef SCANNER_SSE2
+    const __m128i va = _mm_set1_epi8(a);
+    const __m128i vb = _mm_set1_epi8(b);
+    const __m128i vc = _mm_set1_epi8(c);
+
+    while (index + 16 <= end) {
+        __m128i bytes = _mm_loadu_si128((const __m128i*)(text + index));
+        __m128i match = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(bytes, va), _mm_cmpeq_epi8(bytes, vb)),
+            _mm_cmpeq_epi8(bytes, vc));
+        int mask = _mm_movemask_epi8(match);
+
+        if (mask) return index + ScannerFirstBit(mask);
+
+        index += 16;
+    }
+#endif
+
+    while (index < end) {
+        char x = text[index];
+
+        if (x == a || x == b || x == c) break;
+
+        ++index;
+    }
+
+    return index;
+}
+
 // adds all scanned tokens into root opNode
 void opScanner::AddTokensToRoot(FileNode* root) {
-    opList<opToken>::iterator start = Tokens.Begin();
-    opList<opToken>::iterator end = Tokens.End();
+    AddTokensToRoot(Tokens, Buffer, root);
+}
+
+void opScanner::AddTokensToRoot(const opArray<opToken>& tokens,
+                                const opSourceBuffer& buffer,
+                                FileNode* root) {
+    opArray<opToken>::const_iterator start = tokens.Begin();
+    opArray<opToken>::const_iterator end = tokens.End();
+
+    // dialect terminals are read by every compile job, so they
+    // can't materialize lazily
+    bool bViews = buffer && node_cast<OPFileNode>(root);
+
+    if (bViews) root->SetSourceBuffer(buffer);
 
     while (start != end) {
         stacked<TerminalNode> newNode = NEWNODE(TerminalNode(*start, root));
+
+        if (!bViews) newNode->Materialize();
+
         root->AppendNode(newNode);
         ++start;
     }
 }
 
+//
+// Scanned File Cache
+//
+
+opMap<opString, opScanner::ScannedFile> opScanner::Scanned;
+boost::mutex opScanner::ScannedMutex;
+
+const opScanner::ScannedFile* opScanner::FindScanned(const opString& file,
+                                                     ScanMode mode) {
+    boost::mutex::scoped_lock lock(ScannedMutex);
+
+    opMap<opString, ScannedFile>::iterator it =
+        Scanned.Find(file + "|" + opString((int)mode));
+
+    if (it == Scanned.End()) return NULL;
+
+    return &it->second;
+}
+
+void opScanner::StoreScanned(const opString& file, ScanMode mode,
+                             const opSourceBuffer& buffer,
+                             const opArray<opToken>& tokens) {
+    boost::mutex::scoped_lock lock(ScannedMutex);
+
+    opString key = file + "|" + opString((int)mode);
+
+    // another job may have stored it first, it's the same
+    if (Scanned.Contains(key)) return;
+
+    ScannedFile scanned;
+    scanned.Buffer = buffer;
+    scanned.Tokens = tokens;
+
+    Scanned.Insert(key, scanned);
+}
+
+void opScanner::ClearScanned() {
+    boost::mutex::scoped_lock lock(ScannedMutex);
+
+    Scanned.Clear();
+}
+
+//
+// Post Scanning
+//
+
+// The post scanning passes run as a chain of stages.  ScanTokens emits
+// each token into the first stage, and a stage only holds on to the
+// tokens it may still merge into its front token, so the final tokens
+// come out of one walk over the file.  A stage only ever sees tokens the
+// stage before it is done with, which keeps the result the same as
+// running each pass over the whole token list in turn.
+
+namespace scanner {
+
+class opTokenStage {
+   public:
+    opTokenStage(opTokenStage* next) : Next(next) {}
+    virtual ~opTokenStage() {}
+
+    virtual void Push(opToken& token) {
+        if (Held.IsEmpty() && !CanStart(token)) {
+            Next->Push(token);
+            return;
+        }
+
+        Held.PushBack(token);
+        Process(false);
+    }
+
+    // passes on the held tokens at the end of the file
+    virtual void Flush() {
+        Process(true);
+        Next->Flush();
+    }
+
+   protected:
+    enum MatchResult {
+        MR_Done,    // the front token is finished
+        MR_More,    // not enough tokens to decide yet
+        MR_Merged,  // the held tokens changed, look again
+    };
+
+    // returns true if a match can begin at this token
+    virtual bool CanStart(const opToken& token) = 0;
+
+    // tries to match at the front of Held (CanStart is true for it)
+    virtual MatchResult Match() = 0;
+
+    // called after the front token is passed on
+    virtual void Done() {}
+
+    // returns the index of the first held token after the front that
+    // isn't whitespace or a newline, or the held size if there isn't one
+    int SkipSpace() const {
+        int i = 1;
+
+        while (i < Held.Size() &&
+               (Held[i].Id == T_WHITESPACE || Held[i].Id == T_NEWLINE))
+            i++;
+
+        return i;
+    }
+
+    // appends held tokens [1, last] to the front token and removes them
+    void MergeFront(int last) {
+        for (int i = 1; i <= last; i++) Held[0].Append(Held[i]);
+
+        Held.Erase(Held.Begin() + 1, Held.Begin() + last + 1);
+    }
+
+    opArray<opToken> Held;
+    opTokenStage* Next;
+
+   private:
+    void Process(bool bFinal) {
+        while (!Held.IsEmpty()) {
+            MatchResult result = CanStart(Held[0]) ? Match() : MR_Done;
+
+            if (result == MR_Merged) continue;
+
+            if (result == MR_More && !bFinal) return;
+
+            Next->Push(Held[0]);
+            Held.Erase(0);
+            Done();
+        }
+    }
+};
+
+namespace {
+
+// the end of the chain, collects the final tokens
+class TokenOutputStage : public opTokenStage {
+   public:
+    TokenOutputStage(opArray<opToken>& tokens)
+        : opTokenStage(NULL), Tokens(tokens) {}
+
+    virtual void Push(opToken& token) { Tokens.PushBack(token); }
+
+    virtual void Flush() {}
+
+   protected:
+    virtual bool CanStart(const opToken& token) { return false; }
+
+    virtual MatchResult Match() { return MR_Done; }
+
+   private:
+    opArray<opToken>& Tokens;
+};
+
+// checks for a preprocessor directive ("#define" or "# define")
+class PreprocessorStage : public opTokenStage {
+   public:
+    PreprocessorStage(opTokenStage* next) : opTokenStage(next) {}
+
+   protected:
+    virtual bool CanStart(const opToken& token) {
+        return token.Id == T_POUND;
+    }
+
+    virtual MatchResult Match() {
+        if (Held.Size() < 2) return MR_More;
+
+        int keyword = 1;
+
+        if (Held[1].Id == T_WHITESPACE) {
+            if (Held.Size() < 3) return MR_More;
+
+            keyword = 2;
+        }
+
+        if (!opScanner::IsPreprocessorKeyword(Held[keyword])) return MR_Done;
+
+        Held[0].Id = opTokenMap::GetToken(Held[keyword].GetText(),
+                                          Held[keyword].Size());
+        Held[0].Append(Held[keyword]);
+
+        Held.Erase(Held.Begin() + 1, Held.Begin() + keyword + 1);
+
+        return MR_Merged;
+    }
+};
+
+// fixstrings - if you have T_STRING T_STRING (with only whitespace and
+// newlines between), merge them into one T_STRING
+class StringStage : public opTokenStage {
+   public:
+    StringStage(opTokenStage* next) : opTokenStage(next) {}
+
+   protected:
+    virtual bool CanStart(const opToken& token) {
+        return token.Id == T_STRING;
+    }
+
+    virtual MatchResult Match() {
+        int next = SkipSpace();
+
+        if (next == Held.Size()) return MR_More;
+
+        if (Held[next].Id != T_STRING) return MR_Done;
+
+        Held[0].SetValue("\"" + Held[0].GetValue().TrimQuotes() +
+                         Held[next].GetValue().TrimQuotes() + "\"");
+
+        Held.Erase(Held.Begin() + 1, Held.Begin() + next + 1);
+
+        return MR_Merged;
+    }
+};
+
+// keyword - checks if each token exists in the symbol map to see if
+// it's a keyword
+class KeywordStage : public opTokenStage {
+   public:
+    KeywordStage(opTokenStage* next, opScanner::ScanMode mode)
+        : opTokenStage(next), Mode(mode) {}
+
+    virtual void Push(opToken& token) {
+        Token id = opTokenMap::GetToken(token.GetText(), token.Size());
+
+        if (id != T_UNKNOWN) {
+            if (Mode != opScanner::SM_DialectMode &&
+                TokenFunctions::IsDialectToken(id)) {
+                // dialect keywords are ids outside of dialects
+            } else if (Mode != opScanner::SM_NormalMode &&
+                       TokenFunctions::IsNormalToken(id)) {
+                // and normal keywords are ids inside them
+            } else
+                token.Id = id;
+        }
+
+        Next->Push(token);
+    }
+
+   protected:
+    virtual bool CanStart(const opToken& token) { return false; }
+
+    virtual MatchResult Match() { return MR_Done; }
+
+   private:
+    opScanner::ScanMode Mode;
+};
+
+// basic type - labels all ISO standard/microsoft basic types with an id
+// of T_BASIC_TYPE, and merges multiple word types ("long long")
+class BasicTypeStage : public opTokenStage {
+   public:
+    BasicTypeStage(opTokenStage* next) : opTokenStage(next) {}
+
+    virtual void Push(opToken& token) {
+        if (opScanner::IsBasicType(token)) token.Id = T_BASIC_TYPE;
+
+        opTokenStage::Push(token);
+    }
+
+   protected:
+    virtual bool CanStart(const opToken& token) {
+        return token.Id == T_BASIC_TYPE;
+    }
+
+    virtual MatchResult Match() {
+        if (Held.Size() < 2) return MR_More;
+
+        if (Held[1].Id != T_WHITESPACE) return MR_Done;
+
+        if (Held.Size() < 3) return MR_More;
+
+        if (Held[2].Id != T_BASIC_TYPE) return MR_Done;
+
+        opString value = Held[0].GetValue() + " " + Held[2].GetValue();
+
+        if (!opScanner::IsBasicType(value)) return MR_Done;
+
+        Held[0].SetValue(value);
+
+        Held.Erase(Held.Begin() + 1, Held.Begin() + 3);
+
+        return MR_Merged;
+    }
+};
+
+// if a token is a user-defined opobject or openum (or an alternative
+// class, struct or enum prefix for one), update its id
+class UserDefinedStage : public opTokenStage {
+   public:
+    UserDefinedStage(opTokenStage* next)
+        : opTokenStage(next),
+          bPrefix(false),
+          ClassCategory(NULL),
+          StructCategory(NULL),
+          Enumeration(NULL) {}
+
+   protected:
+    virtual bool CanStart(const opToken& token) { return token.Id == T_ID; }
+
+    virtual MatchResult Match() {
+        opToken& front = Held[0];
+
+        if (!bPrefix) {
+            opSymbol value = opSymbol::Intern(front.GetText(), front.Size());
+
+            front.Symbol = value;
+
+            // If this is a registered category, change the id.
+            if (DialectTracker::GetCategory(value)) {
+                front.Id = T_OPOBJECT;
+                return MR_Done;
+            }
+
+            // If this is a registered enumeration, change the id.
+            if (DialectTracker::GetEnumeration(value)) {
+                front.Id = T_OPENUM;
+                return MR_Done;
+            }
+
+            ClassCategory = DialectTracker::GetAltClassPrefix(value);
+            StructCategory = DialectTracker::GetAltStructPrefix(value);
+            Enumeration = DialectTracker::GetAltEnumerationPrefix(value);
+
+            if (!ClassCategory && !StructCategory && !Enumeration)
+                return MR_Done;
+
+            bPrefix = true;
+        }
+
+        // a prefix is replaced along with the class, struct or enum
+        // keyword after it
+        int next = SkipSpace();
+
+        if (next == Held.Size()) return MR_More;
+
+        Token id = Held[next].Id;
+
+        if (ClassCategory && id == T_CLASS)
+            FixAltPrefix(next, T_OPOBJECT, ClassCategory->GetName());
+        else if (StructCategory && id == T_STRUCT)
+            FixAltPrefix(next, T_OPOBJECT, StructCategory->GetName());
+        else if (Enumeration && id == T_ENUM)
+            FixAltPrefix(next, T_OPENUM, Enumeration->GetName());
+
+        return MR_Done;
+    }
+
+    virtual void Done() { bPrefix = false; }
+
+   private:
+    void FixAltPrefix(int keyword, Token replacement, TerminalNode* name) {
+        Held.Erase(Held.Begin() + 1, Held.Begin() + keyword + 1);
+
+        Held[0].Id = replacement;
+        Held[0].SetValue(name->GetValue());
+    }
+
+    // the alternative prefixes the front token is
+    bool bPrefix;
+    CategoryNode* ClassCategory;
+    CategoryNode* StructCategory;
+    EnumerationNode* Enumeration;
+};
+
+// continue line ("\" followed optionally by whitespace, then by a newline)
+class ContinueLineStage : public opTokenStage {
+   public:
+    ContinueLineStage(opTokenStage* next) : opTokenStage(next) {}
+
+   protected:
+    virtual bool CanStart(const opToken& token) {
+        return token.Id == T_BACKSLASH;
+    }
+
+    virtual MatchResult Match() {
+        if (Held.Size() < 2) return MR_More;
+
+        int newline = 1;
+
+        if (Held[1].Id == T_WHITESPACE) {
+            if (Held.Size() < 3) return MR_More;
+
+            newline = 2;
+        }
+
+        if (Held[newline].Id != T_NEWLINE) return MR_Done;
+
+        Held[0].Id = T_CONTINUELINE;
+        Held[0].Append(Held[newline]);
+
+        Held.Erase(Held.Begin() + 1, Held.Begin() + newline + 1);
+
+        return MR_Merged;
+    }
+};
+
+// locates decimals (X., X.X, and either with a float flag)
+class DecimalStage : public opTokenStage {
+   public:
+    DecimalStage(opTokenStage* next) : opTokenStage(next), Part(DP_Dot) {}
+
+   protected:
+    virtual bool CanStart(const opToken& token) {
+        return Part != DP_Dot || token.Id == T_NUMBER;
+    }
+
+    virtual MatchResult Match() {
+        if (Held.Size() < 2) return MR_More;
+
+        switch (Part) {
+            case DP_Dot:
+                if (Held[1].Id != T_DOT) return MR_Done;
+
+                Held[0].Id = T_DECIMAL;
+                MergeFront(1);
+                Part = DP_Fraction;
+                return MR_Merged;
+
+            // case X.X
+            case DP_Fraction:
+                if (Held[1].Id == T_NUMBER) MergeFront(1);
+
+                Part = DP_Flag;
+                return MR_Merged;
+
+            // cases X.f, X.F, X.Xf, X.XF, X.l, X.L, X.Xl, X.XL
+            default:
+                if (opScanner::IsFloatFlagToken(Held[1])) MergeFront(1);
+
+                return MR_Done;
+        }
+    }
+
+    virtual void Done() { Part = DP_Dot; }
+
+   private:
+    // the part of the front decimal to look for next
+    enum DecimalPart {
+        DP_Dot,
+        DP_Fraction,
+        DP_Flag,
+    };
+
+    DecimalPart Part;
+};
+
+// locates exponentials (XeX, X.eX), "e" and the digits are one T_ID
+class ExponentStage : public opTokenStage {
+   public:
+    ExponentStage(opTokenStage* next) : opTokenStage(next) {}
+
+   protected:
+    virtual bool CanStart(const opToken& token) {
+        return token.Id == T_NUMBER || opScanner::IsBareDecimal(token);
+    }
+
+    virtual MatchResult Match() {
+        if (Held.Size() < 2) return MR_More;
+
+        if (!opScanner::IsExpID(Held[1])) return MR_Done;
+
+        Held[0].Id = T_EXPONENTIAL;
+        MergeFront(1);
+
+        return MR_Merged;
+    }
+};
+
+// locates signed exponentials (Xe+X, X.e-X)
+class SignedExponentStage : public opTokenStage {
+   public:
+    SignedExponentStage(opTokenStage* next) : opTokenStage(next) {}
+
+   protected:
+    virtual bool CanStart(const opToken& token) {
+        return token.Id == T_NUMBER || opScanner::IsBareDecimal(token);
+    }
+
+    virtual MatchResult Match() {
+        if (Held.Size() < 2) return MR_More;
+
+        if (!opScanner::IsExpToken(Held[1])) return MR_Done;
+
+        if (Held.Size() < 3) return MR_More;
+
+        if (!opScanner::IsSignToken(Held[2])) return MR_Done;
+
+        if (Held.Size() < 4) return MR_More;
+
+        if (Held[3].Id != T_NUMBER) return MR_Done;
+
+        Held[0].Id = T_EXPONENTIAL;
+        MergeFront(3);
+
+        return MR_Merged;
+    }
+};
+
+// merges a token with the one after it
+// (T_ID = "L" and T_STRING into T_WIDESTRING = L"string", and
+//  T_ID = "c" and T_PLUS_PLUS into T_CPLUSPLUS = "c++")
+class PairStage : public opTokenStage {
+   public:
+    PairStage(opTokenStage* next, const char* text, Token second,
+              Token merged)
+        : opTokenStage(next), Text(text), Second(second), Merged(merged) {}
+
+   protected:
+    virtual bool CanStart(const opToken& token) {
+        return token.Id == T_ID && token.Equals(Text);
+    }
+
+    virtual MatchResult Match() {
+        if (Held.Size() < 2) return MR_More;
+
+        if (Held[1].Id != Second) return MR_Done;
+
+        Held[0].Id = Merged;
+        MergeFront(1);
+
+        return MR_Merged;
+    }
+
+   private:
+    const char* Text;
+    Token Second;
+    Token Merged;
+};
+
+// makes it so if you have T_NUMBER = 3000, T_ID = ul,
+// that T_NUMBER = 3000ul, etc.
+class NumberSuffixStage : public opTokenStage {
+   public:
+    NumberSuffixStage(opTokenStage* next) : opTokenStage(next) {}
+
+   protected:
+    virtual bool CanStart(const opToken& token) {
+        return token.Id == T_NUMBER || token.Id == T_HEXADECIMAL;
+    }
+
+    virtual MatchResult Match() {
+        if (Held.Size() < 2) return MR_More;
+
+        if (!opScanner::IsIntegerSuffix(Held[1])) return MR_Done;
+
+        MergeFront(1);
+
+        return MR_Merged;
+    }
+};
+
+}  // namespace
+
+}  // end namespace scanner
+
+void opScanner::Emit(opToken token) { Stages->Push(token); }
+
 // scans the Input into a symbol list
 bool opScanner::Scan(FileReadStream& ifs, ScanMode mode, opNode* root) {
     Tokens.Clear();
@@ -39,33 +807,46 @@ bool opScanner::Scan(FileReadStream& ifs, ScanMode mode, opNode* root) {
     scanMode = mode;
     Root = root;
 
-    inputtype Input;
-    ifs.ReadToContainer(Input);
+    // the tokens view this buffer, it's never changed after scanning
+    std::shared_ptr<inputtype> buffer(new inputtype);
+    inputtype& Input = *buffer;
+    ifs.ReadToBuffer(Input);
 
-    FixNewlines(Input);
+    Buffer = buffer;
 
-    int it = 0;
+    opBenchmark::CountBytesRead(Input.Size());
 
-    ScanTokens(Input);
+    // post scanning stages, built from the last to the first
+    TokenOutputStage output(Tokens);
+    opTokenStage* next = &output;
 
-    if (opError::HasErrors()) return false;
+    PairStage cplusplus(next, "c", T_PLUS_PLUS, T_CPLUSPLUS);
+    if (scanMode == SM_NormalMode) next = &cplusplus;
 
-    // post scanning stuff
-    Preprocessor();
-    FixStrings();
-    Keyword();
+    NumberSuffixStage numbers(next);
+    PairStage widestrings(&numbers, "L", T_STRING, T_WIDESTRING);
+    SignedExponentStage signedexponents(&widestrings);
+    ExponentStage exponents(&signedexponents);
+    DecimalStage decimals(&exponents);
+    ContinueLineStage continuelines(&decimals);
+    next = &continuelines;
 
-    if (scanMode != SM_DialectMode) {
-        BasicType();
-        UserDefined();
-    }
+    UserDefinedStage userdefined(next);
+    BasicTypeStage basictypes(&userdefined);
+    if (scanMode != SM_DialectMode) next = &basictypes;
+
+    KeywordStage keywords(next, scanMode);
+    StringStage strings(&keywords);
+    PreprocessorStage preprocessor(&strings);
 
-    ContinueLines();
-    Decimals();
-    WideStrings();
-    FixNumbers();
+    Stages = &preprocessor;
 
-    if (scanMode == SM_NormalMode) CPlusPlus();
+    ScanTokens(Input);
+
+    Stages->Flush();
+    Stages = NULL;
+
+    if (opError::HasErrors()) return false;
 
     ScanComplete = true;
 
@@ -74,8 +855,8 @@ bool opScanner::Scan(FileReadStream& ifs, ScanMode mode, opNode* root) {
 
 // prints tokens - for testing
 void opScanner::Print(ostream& o) {
-    opList<opToken>::iterator start = Tokens.Begin();
-    opList<opToken>::iterator end = Tokens.End();
+    opArray<opToken>::iterator start = Tokens.Begin();
+    opArray<opToken>::iterator end = Tokens.End();
 
     while (start != end) {
         opString output = TokenFunctions::ToString(start->Id) + " (" +
@@ -86,7 +867,7 @@ void opScanner::Print(ostream& o) {
         if (start->Id == T_NEWLINE)
             o << "\\n";
         else if (start->Id != T_WHITESPACE)
-            o << start->Value;
+            o << start->GetValue();
 
         o << endl;
 
@@ -94,154 +875,140 @@ void opScanner::Print(ostream& o) {
     }
 }
 
-// fixes stupid "\r\n" thing
-void opScanner::FixNewlines(inputtype& Input) {
-    if (Input.Size() >= 2) {
-        inputiterator one = Input.Begin();
-        inputiterator two = ++(Input.Begin());
-        inputiterator end = Input.End();
-
-        while (two != end) {
-            if (*one == '\r' && *two == '\n') {
-                // fast fix...
-                // set \r to whitespace
-                *one = ' ';
-            }
-
-            ++one;
-            ++two;
-        }
-    }
-}
-
-// Fix alternative prefixes.
-template <Token Type, Token Replacement>
-bool opScanner::FixAltPrefix(opList<opToken>::iterator& start,
-                             TerminalNode* name) {
-    opList<opToken>::iterator end = Tokens.end();
-    opList<opToken>::iterator j = start;
-
-    ++j;
-
-    while (j != end && (j->Id == T_WHITESPACE || j->Id == T_NEWLINE)) {
-        ++j;
-    }
-
-    if (j != end && j->Id == Type) {
-        opList<opToken>::iterator k = start;
-
-        ++k;
-        ++j;
-
-        Tokens.Erase(k, j);
-
-        start->Id = Replacement;
-        start->Value = name->GetValue();
-
-        return true;
-    }
-
-    return false;
-}
-
 // parses the next token
 // returns false if done
-void opScanner::ScanTokens(const inputtype& Input) {
+void opScanner::ScanTokens(inputtype& Input) {
     // if we've reached the end of the Input stream,
     // add an EOF token and return false
 
-    int size = Input.Size();
-    int current = 0;
-
-    // TODO: the input list of chars is really a bad idea
-    //		Input should be a vector, and we should not alter it,
-    //		instead we should iterate over it (maybe w/ an iterator we pass
-    //		around.
+    size_t size = Input.Size();
+    size_t current = 0;
 
     while (current != size) {
-        // scan for the next token
-        // (with the correct precedence)
-        if (current != size && Newline(Input, current))
-            ;
-        else if (current != size && CComment(Input, current))
-            ;
-        else if (current != size && Comment(Input, current))
-            ;
-        else if (current != size && String(Input, current))
-            ;
-        else if (current != size && WhiteSpace(Input, current))
-            ;
-        else if (current != size && Operator(Input, current))
-            ;
-        else if (current != size && Hexadecimals(Input, current))
-            ;
-        else if (current != size && Number(Input, current))
-            ;
-        else if (current != size && GetId(Input, current))
-            ;
-        else if (current != size) {
-            opToken newToken(T_ANYCHAR, Input[current], CurrentLine);
-
-            Tokens.PushBack(newToken);
-            ++current;
-        }
+        char c = Input[current];
+
+        if (SpaceCR(&Input[0], current, size)) c = ' ';
+
+        int type = CharTypes[(unsigned char)c];
+
+        // skip the scanners that can't match the first byte
+        if (type & CT_NEWLINE)
+            Newline(Input, current);
+        else if (c == '/')
+            ScanInOrder(Input, current, SO_CComment);
+        else if (type & CT_QUOTE)
+            ScanInOrder(Input, current, SO_String);
+        else if (type & CT_WHITESPACE)
+            WhiteSpace(Input, current);
+        else if (type & (CT_ALPHA | CT_UNDERSCORE))
+            GetId(Input, current);
+        else if (type & CT_DIGIT)
+            ScanInOrder(Input, current, SO_Hexadecimals);
+        else
+            ScanInOrder(Input, current, SO_Operator);
     }
 
-    Tokens.PushBack(opToken(T_EOF, "", CurrentLine));
+    Emit(opToken(T_EOF, "", CurrentLine));
+}
+
+// scan for the next token (with the correct precedence), unbounded
+// comments and strings fail part way, so the rest see where they stopped
+void opScanner::ScanInOrder(inputtype& Input, size_t& current,
+                            ScanOrder first) {
+    size_t size = Input.Size();
+
+    if (first <= SO_Newline && current != size && Newline(Input, current))
+        ;
+    else if (first <= SO_CComment && current != size &&
+             CComment(Input, current))
+        ;
+    else if (first <= SO_Comment && current != size && Comment(Input, current))
+        ;
+    else if (first <= SO_String && current != size && String(Input, current))
+        ;
+    else if (first <= SO_WhiteSpace && current != size &&
+             WhiteSpace(Input, current))
+        ;
+    else if (first <= SO_Operator && current != size &&
+             Operator(Input, current))
+        ;
+    else if (first <= SO_Hexadecimals && current != size &&
+             Hexadecimals(Input, current))
+        ;
+    else if (first <= SO_Number && current != size && Number(Input, current))
+        ;
+    else if (first <= SO_GetId && current != size && GetId(Input, current))
+        ;
+    else if (current != size) {
+        opToken newToken(T_ANYCHAR, &Input[current], 1, CurrentLine);
+
+        Emit(newToken);
+        ++current;
+    }
 }
 
 // newline - parses a newline
-bool opScanner::Newline(const inputtype& Input, int& current) {
+bool opScanner::Newline(inputtype& Input, size_t& current) {
     char c = Input[current];
 
     if (!IsNewline(c)) return false;
 
-    opToken newToken(T_NEWLINE, '\n', CurrentLine);
+    // a lone '\r' still prints as '\n'
+    opToken newToken = (c == '\n')
+                           ? opToken(T_NEWLINE, &Input[current], 1, CurrentLine)
+                           : opToken(T_NEWLINE, "\n", CurrentLine);
 
     ++CurrentLine;
 
-    Tokens.PushBack(newToken);
+    Emit(newToken);
     ++current;
 
     return true;
 }
 
 // scans for a c-style comment
-bool opScanner::CComment(const inputtype& Input, int& current) {
-    int size = Input.Size();
+bool opScanner::CComment(inputtype& Input, size_t& current) {
+    size_t size = Input.Size();
 
     if (current + 1 < size) {
-        int one = current;
-        int two = current + 1;
+        size_t one = current;
+        size_t two = current + 1;
 
         if (Input[one] == '/' && Input[two] == '*') {
-            opToken newToken(T_CCOMMENT, "/*", CurrentLine);
+            size_t start = current;
+            int line = CurrentLine;
             bool bFoundEnd = false;
 
             current += 2;
 
             while (current + 1 < size) {
+                // the last character can't start "*/"
+                current =
+                    FindAny(&Input[0], current, size - 1, '*', '\n', '\r');
+
+                if (current + 1 >= size) break;
+
                 one = current;
                 two = current + 1;
 
                 if (Input[one] == '*' && Input[two] == '/') {
-                    newToken.Value += "*/";
-
                     current += 2;
 
                     bFoundEnd = true;
                     break;
                 } else {
-                    if (IsNewline(Input[one])) ++CurrentLine;
+                    if (!SpaceCR(&Input[0], one, size) && IsNewline(Input[one]))
+                        ++CurrentLine;
 
-                    newToken.Value += Input[one];
                     ++current;
                 }
             }
 
+            opToken newToken(T_CCOMMENT, &Input[start], current - start, line);
+
             // check for unbounded comments
             if (bFoundEnd) {
-                Tokens.PushBack(newToken);
+                Emit(newToken);
 
                 return true;
             } else {
@@ -255,28 +1022,23 @@ bool opScanner::CComment(const inputtype& Input, int& current) {
 }
 
 // scans for a comment
-bool opScanner::Comment(const inputtype& Input, int& current) {
-    int size = Input.Size();
+bool opScanner::Comment(inputtype& Input, size_t& current) {
+    size_t size = Input.Size();
 
     if (current + 1 < size) {
-        int one = current;
-        int two = current + 1;
+        size_t one = current;
+        size_t two = current + 1;
 
         if (Input[one] == '/' && Input[two] == '/') {
-            opToken newToken(T_COMMENT, "//", CurrentLine);
-
-            current += 2;
+            size_t start = current;
 
-            while (current < size) {
-                one = current;
+            current = FindAny(&Input[0], current + 2, size, '\n', '\r', '\n');
 
-                if (IsNewline(Input[one])) break;
-
-                newToken.Value += Input[one];
+            if (current != size && SpaceCR(&Input[0], current, size))
                 ++current;
-            }
 
-            Tokens.PushBack(newToken);
+            Emit(opToken(T_COMMENT, &Input[start], current - start,
+                         CurrentLine));
 
             return true;
         }
@@ -286,26 +1048,27 @@ bool opScanner::Comment(const inputtype& Input, int& current) {
 }
 
 // scans for strings
-bool opScanner::String(const inputtype& Input, int& current) {
+bool opScanner::String(inputtype& Input, size_t& current) {
     char start = Input[current];
-    int size = Input.Size();
-    int count = 0;
+    size_t size = Input.Size();
 
     if (start == '\"' || start == '\'') {
-        opToken newToken((start == '\"') ? T_STRING : T_CHAR, start,
-                         CurrentLine);
-        char c, last;
+        Token id = (start == '\"') ? T_STRING : T_CHAR;
+        size_t first = current;
 
-        ++count;
         ++current;
 
-        c = start;
-
         while (current < size) {
-            last = c;
-            c = Input[current];
+            // only quotes and newlines end a string
+            current = FindAny(&Input[0], current, size, start, '\n', '\r');
+
+            if (current == size) break;
 
-            if (IsNewline(c)) {
+            char last = Input[current - 1];
+            char c = Input[current];
+            size_t count = current - first;
+
+            if (IsNewline(c) && !SpaceCR(&Input[0], current, size)) {
                 opError::UnboundedStringError(Root, CurrentLine);
                 ScanError = true;
                 return false;
@@ -315,17 +1078,15 @@ bool opScanner::String(const inputtype& Input, int& current) {
             if (c == start) {
                 // Handle special cases.
                 if (last != '\\' || (last == '\\' && count >= 3 &&
-                                     newToken.Value[count - 2] == '\\')) {
-                    newToken.Value += c;
+                                     Input[current - 2] == '\\')) {
                     ++current;
-                    Tokens.PushBack(newToken);
+                    Emit(opToken(id, &Input[first], current - first,
+                                 CurrentLine));
                     return true;
                 }
             }
 
-            newToken.Value += c;
             ++current;
-            ++count;
         }
 
         opError::UnboundedStringError(Root, CurrentLine);
@@ -336,24 +1097,17 @@ bool opScanner::String(const inputtype& Input, int& current) {
 }
 
 // scans for whitespace
-bool opScanner::WhiteSpace(const inputtype& Input, int& current) {
+bool opScanner::WhiteSpace(inputtype& Input, size_t& current) {
     char c = Input[current];
-    int size = Input.Size();
+    size_t size = Input.Size();
 
-    if (IsWhiteSpace(c)) {
-        opToken newToken(T_WHITESPACE, c, CurrentLine);
-        ++current;
+    if (IsWhiteSpace(c) || SpaceCR(&Input[0], current, size)) {
+        size_t start = current;
 
-        while (current < size) {
-            c = Input[current];
+        current = SkipWhiteSpace(&Input[0], current + 1, size);
 
-            if (!IsWhiteSpace(c)) break;
-
-            newToken.Value += c;
-            ++current;
-        }
-
-        Tokens.PushBack(newToken);
+        Emit(opToken(T_WHITESPACE, &Input[start], current - start,
+                     CurrentLine));
 
         return true;
     }
@@ -362,44 +1116,39 @@ bool opScanner::WhiteSpace(const inputtype& Input, int& current) {
 }
 
 // operator - parses an operator
-bool opScanner::Operator(const inputtype& Input, int& current) {
+bool opScanner::Operator(inputtype& Input, size_t& current) {
     char c = Input[current];
 
     // if this character is an operator character,
     // try to parse it as an operator
     if (IsOperatorChar(c)) {
-        opString op = c;
-        int start = current + 1;
-        int end = Input.Size();
-        Token id;
-        int length;
-
-        // create a string with all consecutive
-        // operator characters
+        size_t start = current + 1;
+        size_t end = Input.Size();
+        Token id = T_UNKNOWN;
+        size_t length;
+
+        // find all consecutive operator characters
         while (start != end) {
             c = Input[start];
 
             if (!IsOperatorChar(c)) break;
 
-            op += c;
             ++start;
         }
 
         // find the largest string that is a
         // valid operator
-        while ((id = opTokenMap::GetToken(op)) == T_UNKNOWN) op.PopBack();
+        for (length = start - current; length > 0; length--) {
+            id = opTokenMap::GetToken(&Input[current], length);
 
-        length = op.Length();
+            if (id != T_UNKNOWN) break;
+        }
 
         if (length == 0) return false;
 
-        opToken newToken(id, op, CurrentLine);
-
-        Tokens.PushBack(newToken);
+        Emit(opToken(id, &Input[current], length, CurrentLine));
 
-        for (int i = 0; i < length; i++) {
-            ++current;
-        }
+        current += length;
 
         return true;
     }
@@ -408,17 +1157,16 @@ bool opScanner::Operator(const inputtype& Input, int& current) {
 }
 
 // parses a hex number
-bool opScanner::Hexadecimals(const inputtype& Input, int& current) {
+bool opScanner::Hexadecimals(inputtype& Input, size_t& current) {
     if (current + 2 < Input.Size()) {
-        int one = current;
-        int two = current + 1;
-        int three = current + 2;
+        size_t one = current;
+        size_t two = current + 1;
+        size_t three = current + 2;
 
         if (Input[one] == '0' && (Input[two] == 'x' || Input[two] == 'X') &&
             IsHexDigit(Input[three])) {
-            int end = Input.Size();
-            opToken newToken(T_HEXADECIMAL, opString("0x") + Input[three],
-                             CurrentLine);
+            size_t end = Input.Size();
+            size_t start = current;
 
             current += 3;
 
@@ -427,13 +1175,19 @@ bool opScanner::Hexadecimals(const inputtype& Input, int& current) {
             while (one != end) {
                 if (!IsHexDigit(Input[one])) break;
 
-                newToken.Value += Input[one];
                 ++current;
 
                 one = current;
             }
 
-            Tokens.PushBack(newToken);
+            opToken newToken(T_HEXADECIMAL, &Input[start], current - start,
+                             CurrentLine);
+
+            // the prefix is always printed as "0x"
+            if (Input[two] == 'X')
+                newToken.SetValue("0x" + newToken.GetValue().Right(1));
+
+            Emit(newToken);
 
             return true;
         }
@@ -443,12 +1197,12 @@ bool opScanner::Hexadecimals(const inputtype& Input, int& current) {
 }
 
 // parses a number (an integer)
-bool opScanner::Number(const inputtype& Input, int& current) {
+bool opScanner::Number(inputtype& Input, size_t& current) {
     char c = Input[current];
-    int size = Input.Size();
+    size_t size = Input.Size();
 
     if (IsDigit(c)) {
-        opToken newToken(T_NUMBER, c, CurrentLine);
+        size_t start = current;
         ++current;
 
         while (current + 1 < size) {
@@ -456,11 +1210,10 @@ bool opScanner::Number(const inputtype& Input, int& current) {
 
             if (!IsDigit(c)) break;
 
-            newToken.Value += c;
             ++current;
         }
 
-        Tokens.PushBack(newToken);
+        Emit(opToken(T_NUMBER, &Input[start], current - start, CurrentLine));
 
         return true;
     }
@@ -469,25 +1222,16 @@ bool opScanner::Number(const inputtype& Input, int& current) {
 }
 
 // id - parses an id
-bool opScanner::GetId(const inputtype& Input, int& current) {
+bool opScanner::GetId(inputtype& Input, size_t& current) {
     char c = Input[current];
-    int size = Input.Size();
+    size_t size = Input.Size();
 
     if (IsAlpha(c) || c == '_') {
-        opToken newToken(T_ID, c, CurrentLine);
+        size_t start = current;
 
-        ++current;
+        current = SkipIdChars(&Input[0], current + 1, size);
 
-        while (current < size) {
-            c = Input[current];
-
-            if (!IsAlphaNum(c) && c != '_') break;
-
-            newToken.Value += c;
-            ++current;
-        }
-
-        Tokens.push_back(newToken);
+        Emit(opToken(T_ID, &Input[start], current - start, CurrentLine));
 
         return true;
     }
@@ -495,397 +1239,16 @@ bool opScanner::GetId(const inputtype& Input, int& current) {
     return false;
 }
 
-// checks for a preprocessor directive
-void opScanner::Preprocessor() {
-    if (Tokens.HasSize(2)) {
-        opList<opToken>::iterator one = Tokens.Begin();
-        opList<opToken>::iterator two = ++Tokens.Begin();
-        opList<opToken>::iterator end = Tokens.End();
-
-        while (two != end) {
-            if (one->Id == T_POUND && IsPreprocessorKeyword(two->Value)) {
-                one->Value += two->Value;
-                one->Id = opTokenMap::GetToken(two->Value);
-
-                Tokens.Erase(two);
-                two = one;
-                ++two;
-                continue;
-            }
-
-            ++one;
-            ++two;
-        }
-    }
-
-    if (Tokens.HasSize(3)) {
-        opList<opToken>::iterator one = Tokens.Begin();
-        opList<opToken>::iterator two = ++Tokens.Begin();
-        opList<opToken>::iterator three = ++(++Tokens.Begin());
-        opList<opToken>::iterator end = Tokens.End();
-
-        while (three != end) {
-            if (one->Id == T_POUND && two->Id == T_WHITESPACE &&
-                IsPreprocessorKeyword(three->Value)) {
-                one->Value += three->Value;
-                one->Id = opTokenMap::GetToken(three->Value);
-
-                Tokens.Erase(two);
-                Tokens.Erase(three);
-                two = one;
-                ++two;
-                three = two;
-                ++three;
-                continue;
-            }
-
-            ++one;
-            ++two;
-            ++three;
-        }
-    }
-}
-
-// fixstrings - if you have T_STRING T_STRING,
-// merge them into one T_STRING, etc.
-void opScanner::FixStrings() {
-    if (!Tokens.HasSize(2)) return;
-
-    opList<opToken>::iterator i1 = Tokens.Begin();
-    opList<opToken>::iterator i2 = ++Tokens.Begin();
-    opList<opToken>::iterator i3;
-    opList<opToken>::iterator end = Tokens.End();
-
-    while (i2 != end) {
-        if (i1->Id == T_STRING) {
-            if (i2->Id == T_STRING) {
-                i1->Value.TrimQuotes();
-                i2->Value.TrimQuotes();
-                i1->Value = "\"" + i1->Value + i2->Value + "\"";
-                Tokens.Erase(i2);
-                i2 = i1;
-                ++i2;
-                continue;
-            } else if (i2->Id == T_WHITESPACE || i2->Id == T_NEWLINE) {
-                ++i2;
-
-                while (i2 != end) {
-                    if (i2->Id == T_WHITESPACE || i2->Id == T_NEWLINE) {
-                        ++i2;
-                    } else if (i2->Id != T_STRING) {
-                        i1 = i2;
-                        ++i2;
-                        break;
-                    } else {
-                        i1->Value.TrimQuotes();
-                        i2->Value.TrimQuotes();
-                        i1->Value = "\"" + i1->Value + i2->Value + "\"";
-                        i3 = i1;
-                        ++i3;
-                        ++i2;
-                        Tokens.Erase(i3, i2);
-                        break;
-                    }
-                }
-
-                if (i2 == end) return;
-            } else {
-                ++i1;
-                ++i2;
-            }
-        } else {
-            ++i1;
-            ++i2;
-        }
-    }
-}
-
-// keyword - assumes that the last token parsed
-// is an id.  checks if it exists in the symbol
-// map to see if it's a keyword.
-void opScanner::Keyword() {
-    opList<opToken>::iterator start = Tokens.Begin();
-    opList<opToken>::iterator end = Tokens.End();
-    Token id;
-
-    while (start != end) {
-        // NOTE: could be improved probably.
-        id = opTokenMap::GetToken(start->Value);
-
-        if (id != T_UNKNOWN) {
-            if (scanMode != SM_DialectMode &&
-                TokenFunctions::IsDialectToken(id)) {
-                // 				if(TokenFunctions::IsDialectToken(id))
-                // 					start->Id = id;
-            } else if (scanMode != SM_NormalMode &&
-                       TokenFunctions::IsNormalToken(id)) {
-                // 				if(TokenFunctions::IsNormalToken(id))
-                // 					start->Id = id;
-            } else  // if (scanMode == SM_BasicMode)// &&
-                    // TokenFunctions::IsNormalToken(id))
-            {
-                start->Id = id;
-            }
-        }
-
-        ++start;
-    }
-}
-
-// basic type - labels all ISO standard/microsoft basic types
-// with an id of T_BASIC_TYPE
-void opScanner::BasicType() {
-    opList<opToken>::iterator one = Tokens.Begin();
-    opList<opToken>::iterator end = Tokens.End();
-    opList<opToken>::iterator two;
-    opList<opToken>::iterator three;
-
-    while (one != end) {
-        if (IsBasicType(one->Value)) one->Id = T_BASIC_TYPE;
-
-        ++one;
-    }
-
-    if (Tokens.HasSize(3)) {
-        one = Tokens.Begin();
-        two = ++Tokens.Begin();
-        three = ++(++Tokens.Begin());
-
-        while (three != end) {
-            if (one->Id == T_BASIC_TYPE && two->Id == T_WHITESPACE &&
-                three->Id == T_BASIC_TYPE &&
-                IsBasicType(one->Value + " " + three->Value)) {
-                one->Value += opString(" ") + three->Value;
-
-                Tokens.Erase(two);
-                Tokens.Erase(three);
-                two = one;
-                ++two;
-                three = two;
-                ++three;
-                continue;
-            }
-
-            ++one;
-            ++two;
-            ++three;
-        }
-    }
-}
-
-// if the last token parsed is a user-defined modifier or
-// opobject type, update its id
-void opScanner::UserDefined() {
-    opList<opToken>::iterator start = Tokens.Begin();
-    opList<opToken>::iterator end = Tokens.End();
-
-    while (start != end) {
-        if (start->Id == T_ID) {
-            opString Value = start->Value;
-
-            // If this is a registered category, change the id.
-            if (DialectTracker::GetCategory(Value)) start->Id = T_OPOBJECT;
-            // If this is a registered enumeration, change the id.
-            else if (DialectTracker::GetEnumeration(Value))
-                start->Id = T_OPENUM;
-            else {
-                CategoryNode* classcategory =
-                    DialectTracker::GetAltClassPrefix(Value);
-                CategoryNode* structcategory =
-                    DialectTracker::GetAltStructPrefix(Value);
-                EnumerationNode* enumeration =
-                    DialectTracker::GetAltEnumerationPrefix(Value);
-
-                // Registered class prefix?
-                if (classcategory && FixAltPrefix<T_CLASS, T_OPOBJECT>(
-                                         start, classcategory->GetName())) {
-                    // do nothing
-                }
-                // Registered struct prefix?
-                else if (structcategory &&
-                         FixAltPrefix<T_STRUCT, T_OPOBJECT>(
-                             start, structcategory->GetName())) {
-                    // do nothing
-                }
-                // Registered enum prefix?
-                else if (enumeration && FixAltPrefix<T_ENUM, T_OPENUM>(
-                                            start, enumeration->GetName())) {
-                    // do nothing
-                }
-            }
-        }
-
-        ++start;
-    }
-}
-
-// continue line ("\" followed optionally by whitespace, then by a newline)
-void opScanner::ContinueLines() {
-    if (Tokens.HasSize(2)) {
-        opList<opToken>::iterator one = Tokens.Begin();
-        opList<opToken>::iterator two = ++Tokens.Begin();
-        opList<opToken>::iterator end = Tokens.End();
-
-        while (two != end) {
-            if (one->Id == T_BACKSLASH && two->Id == T_NEWLINE) {
-                one->Id = T_CONTINUELINE;
-                one->Value += two->Value;
-
-                Tokens.Erase(two);
-                two = one;
-                ++two;
-                continue;
-            }
-
-            ++one;
-            ++two;
-        }
-    }
-
-    if (Tokens.HasSize(3)) {
-        opList<opToken>::iterator one = Tokens.Begin();
-        opList<opToken>::iterator two = ++Tokens.Begin();
-        opList<opToken>::iterator three = ++(++Tokens.Begin());
-        opList<opToken>::iterator end = Tokens.End();
-
-        int i = 0;
-
-        while (three != end) {
-            if (one->Id == T_BACKSLASH && two->Id == T_WHITESPACE &&
-                three->Id == T_NEWLINE) {
-                one->Id = T_CONTINUELINE;
-                one->Value += three->Value;
-
-                Tokens.Erase(two);
-                Tokens.Erase(three);
-
-                if (!Tokens.HasSize(3)) break;
-
-                two = one;
-                ++two;
-                three = two;
-                ++three;
-
-                continue;
-            }
-
-            ++one;
-            ++two;
-            ++three;
-            ++i;
-        }
-    }
-}
-
-// locates decimals
-void opScanner::Decimals() {
-    if (Tokens.HasSize(2)) {
-        opList<opToken>::iterator one = Tokens.Begin();
-        opList<opToken>::iterator two = ++Tokens.Begin();
-        opList<opToken>::iterator end = Tokens.End();
-
-        while (two != end) {
-            if (one->Id == T_NUMBER && two->Id == T_DOT) {
-                one->Id = T_DECIMAL;
-                one->Value += two->Value;
-
-                Tokens.Erase(two);
-                two = one;
-                ++two;
-
-                // case X.X
-                if (two != end && two->Id == T_NUMBER) {
-                    one->Value += two->Value;
-                    Tokens.Erase(two);
-                    two = one;
-                    ++two;
-                }
-
-                // cases X.f, X.F, X.Xf, X.XF, X.l, X.L, X.Xl, X.XL
-                if (two != end && IsFloatFlagToken(*two)) {
-                    one->Value += two->Value;
-                    Tokens.Erase(two);
-                    two = one;
-                    ++two;
-                }
-
-                continue;
-            }
-
-            ++one;
-            ++two;
-        }
-    }
-
-    if (Tokens.HasSize(2)) {
-        opList<opToken>::iterator one = Tokens.Begin();
-        opList<opToken>::iterator two = ++Tokens.Begin();
-        opList<opToken>::iterator end = Tokens.End();
-
-        while (two != end) {
-            if ((one->Id == T_NUMBER || IsBareDecimal(*one)) && IsExpID(*two)) {
-                one->Id = T_EXPONENTIAL;
-                one->Value += two->Value;
-
-                Tokens.Erase(two);
-                two = one;
-                ++two;
-                continue;
-            }
-
-            ++one;
-            ++two;
-        }
-    }
-
-    if (Tokens.HasSize(4)) {
-        opList<opToken>::iterator one = Tokens.Begin();
-        opList<opToken>::iterator two = ++Tokens.Begin();
-        opList<opToken>::iterator three = ++(++Tokens.Begin());
-        opList<opToken>::iterator four = ++(++(++Tokens.Begin()));
-        opList<opToken>::iterator end = Tokens.End();
-
-        while (four != end) {
-            if ((one->Id == T_NUMBER || IsBareDecimal(*one)) &&
-                IsExpToken(*two) && IsSignToken(*three) &&
-                four->Id == T_NUMBER) {
-                one->Id = T_EXPONENTIAL;
-                one->Value += two->Value + three->Value + four->Value;
-
-                Tokens.Erase(two);
-                Tokens.Erase(three);
-                Tokens.Erase(four);
-
-                if (!Tokens.HasSize(4)) break;
-
-                two = one;
-                ++two;
-                three = two;
-                ++three;
-                four = three;
-                ++four;
-
-                continue;
-            }
-
-            ++one;
-            ++two;
-            ++three;
-            ++four;
-        }
-    }
-}
-
 // checks if the current token is an exp token ("e" or "E" followed by digits)
 bool opScanner::IsExpID(const opToken& tok) {
     if (tok.Id != T_ID) return false;
 
-    opString s = tok.Value;
-    int size = s.Size();
+    const char* s = tok.GetText();
+    int size = tok.Size();
 
     if (size == 1) return false;
 
-    if (!IsExpChar(s.Front())) return false;
+    if (!IsExpChar(s[0])) return false;
 
     for (int i = 1; i < size; i++) {
         if (!IsDigit(s[i])) return false;
@@ -894,76 +1257,3 @@ bool opScanner::IsExpID(const opToken& tok) {
     return true;
 }
 
-// parses wide strings (L"string")
-void opScanner::WideStrings() {
-    if (Tokens.HasSize(2)) {
-        opList<opToken>::iterator one = Tokens.Begin();
-        opList<opToken>::iterator two = ++Tokens.Begin();
-        opList<opToken>::iterator end = Tokens.End();
-
-        while (two != end) {
-            if (one->Id == T_ID && one->Value == "L" && two->Id == T_STRING) {
-                one->Id = T_WIDESTRING;
-                one->Value += two->Value;
-
-                Tokens.Erase(two);
-                two = one;
-                ++two;
-                continue;
-            }
-
-            ++one;
-            ++two;
-        }
-    }
-}
-
-// makes it so if you have T_NUMBER = 3000, T_ID = ul,
-// that T_NUMBER = 3000ul, etc.
-void opScanner::FixNumbers() {
-    if (Tokens.HasSize(2)) {
-        opList<opToken>::iterator one = Tokens.Begin();
-        opList<opToken>::iterator two = ++Tokens.Begin();
-        opList<opToken>::iterator end = Tokens.End();
-
-        while (two != end) {
-            if ((one->Id == T_NUMBER || one->Id == T_HEXADECIMAL) &&
-                IsIntegerSuffix(*two)) {
-                one->Value += two->Value;
-
-                Tokens.Erase(two);
-                two = one;
-                ++two;
-                continue;
-            }
-
-            ++one;
-            ++two;
-        }
-    }
-}
-
-// Transform T_ID = "c" and T_PLUS_PLUS = "++" into T_CPLUSPLUS = "c++"
-void opScanner::CPlusPlus() {
-    if (Tokens.HasSize(2)) {
-        opList<opToken>::iterator one = Tokens.Begin();
-        opList<opToken>::iterator two = ++Tokens.Begin();
-        opList<opToken>::iterator end = Tokens.End();
-
-        while (two != end) {
-            if (one->Id == T_ID && one->Value == "c" &&
-                two->Id == T_PLUS_PLUS) {
-                one->Id = T_CPLUSPLUS;
-                one->Value = "c++";
-
-                Tokens.Erase(two);
-                two = one;
-                ++two;
-                continue;
-            }
-
-            ++one;
-            ++two;
-        }
-    }
-}
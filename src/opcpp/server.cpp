@@ -0,0 +1,200 @@
+///****************************************************************
+/// Copyright  2008 opGames LLC - All Rights Reserved
+///
+/// Authors: Kevin Depue & Lucas Ellis
+///
+/// File: Server.cpp
+/// Date: 10/17/2026
+///
+/// Description:
+///
+/// Compile server source code.
+///****************************************************************
+
+#include "opcpp/opcpp.h"
+
+//
+// opCompileServer
+//
+
+int opCompileServer::Run(const opParameters& p) {
+    // the parameters are replaced by each request
+    opString socketpath = p.Server.GetValue();
+    bool bSilent = p.Silent;
+
+    opCompileServer server;
+
+    server.Driver.Initialize();
+    server.Driver.SetResidentDialects(true);
+
+    // standard in / out server
+    if (socketpath == "-") {
+        // keep the reply stream clean
+        opLog::SetStream(cerr);
+
+        while (server.HandleRequest(cin, cout))
+            ;
+
+        return 0;
+    }
+
+    // local socket server
+    opString error;
+    sockets::opLocalListener* listener = sockets::Listen(socketpath, error);
+
+    if (!listener) {
+        Log(opString("Error: Could not listen on ") + socketpath + " (" +
+            error + ").");
+        return -1;
+    }
+
+    if (!bSilent)
+        Log(opString("opC++ compile server listening on ") + socketpath);
+
+    while (iostream* stream = sockets::Accept(listener)) {
+        server.HandleRequest(*stream, *stream);
+
+        delete stream;
+    }
+
+    sockets::Close(listener);
+
+    return 0;
+}
+
+bool opCompileServer::Forward(const opParameters& p, int& exitcode) {
+    iostream* stream = sockets::Connect(p.Connect.GetValue());
+
+    if (!stream) return false;
+
+    (*stream) << "cwd " << Escape(current_path().string()) << '\n';
+
+    // forward everything but -connect
+    for (size_t i = 0; i < p.Params.size(); i++) {
+        if (p.Params[i] == "-connect") {
+            i++;
+            continue;
+        }
+
+        (*stream) << "arg " << Escape(p.Params[i].GetString()) << '\n';
+    }
+
+    (*stream) << "compile" << endl;
+
+    // a dropped connection is a failed compile
+    exitcode = 1;
+
+    string line;
+
+    while (getline(*stream, line)) {
+        if (line.compare(0, 4, "log ") == 0)
+            Log(Unescape(line.substr(4)));
+        else if (line.compare(0, 5, "exit ") == 0) {
+            exitcode = atoi(line.substr(5).c_str());
+            break;
+        }
+    }
+
+    delete stream;
+
+    return true;
+}
+
+bool opCompileServer::HandleRequest(istream& in, ostream& out) {
+    opString directory;
+    vector<opString> args;
+    string line;
+
+    while (getline(in, line)) {
+        if (line.compare(0, 4, "cwd ") == 0)
+            directory = Unescape(line.substr(4));
+        else if (line.compare(0, 4, "arg ") == 0)
+            args.push_back(Unescape(line.substr(4)));
+        else if (line == "compile") {
+            opArray<opString> output;
+
+            opLog::SetCapture(&output);
+            int exitcode = Compile(directory, args);
+            opLog::SetCapture(NULL);
+
+            for (int i = 0; i < output.Size(); i++)
+                out << "log " << Escape(output[i].GetString()) << '\n';
+
+            out << "exit " << exitcode << endl;
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+int opCompileServer::Compile(const opString& directory,
+                             const vector<opString>& args) {
+    try {
+        // relative paths are the client's
+        if (directory.Length()) current_path(directory.GetString());
+    } catch (boost::filesystem::filesystem_error&) {
+        Log(opString("Error: Invalid working directory ") + directory);
+        return -1;
+    }
+
+    // every request starts from the default parameters
+    opParameters::Destroy();
+    opStringStream::SetLineDirectives(true);
+
+    opParameters& p = opParameters::GetWritable();
+
+    p.Init(args);
+
+    if (!p.Parse()) return -1;
+
+    if (p.Server.GetUsed() || p.Connect.GetUsed()) {
+        Log("Error: A compile server can't forward requests.");
+        return -1;
+    }
+
+    if (p.Version) {
+        opVersion::PrintVersion();
+        return 0;
+    }
+
+    return Driver.Convert(p) ? 0 : 1;
+}
+
+string opCompileServer::Escape(const string& s) {
+    string escaped;
+
+    for (size_t i = 0; i < s.size(); i++) {
+        if (s[i] == '\\')
+            escaped += "\\\\";
+        else if (s[i] == '\n')
+            escaped += "\\n";
+        else if (s[i] == '\r')
+            escaped += "\\r";
+        else
+            escaped += s[i];
+    }
+
+    return escaped;
+}
+
+string opCompileServer::Unescape(const string& s) {
+    string unescaped;
+
+    for (size_t i = 0; i < s.size(); i++) {
+        if (s[i] == '\\' && i + 1 < s.size()) {
+            i++;
+
+            if (s[i] == 'n')
+                unescaped += '\n';
+            else if (s[i] == 'r')
+                unescaped += '\r';
+            else
+                unescaped += s[i];
+        } else
+            unescaped += s[i];
+    }
+
+    return unescaped;
+}
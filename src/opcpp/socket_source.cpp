@@ -0,0 +1,122 @@
+///****************************************************************
+/// Copyright  2008 opGames LLC - All Rights Reserved
+///
+/// Authors: Kevin Depue & Lucas Ellis
+///
+/// File: SocketSource.cpp
+/// Date: 10/17/2026
+///
+/// Description:
+///
+/// Local Socket Source
+///****************************************************************
+
+#include <boost/asio.hpp>
+#include <boost/version.hpp>
+#include "opcpp/opstl/opstl.h"
+
+#ifdef BOOST_ASIO_HAS_LOCAL_SOCKETS
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace sockets {
+
+#ifdef BOOST_ASIO_HAS_LOCAL_SOCKETS
+
+using boost::asio::local::stream_protocol;
+
+class opLocalListener {
+   public:
+    opLocalListener(const opString& socketpath)
+        : acceptor(service,
+                   stream_protocol::endpoint(socketpath.GetString())) {}
+
+    boost::asio::io_service service;
+    stream_protocol::acceptor acceptor;
+};
+
+iostream* Connect(const opString& socketpath);
+
+opLocalListener* Listen(const opString& socketpath, opString& error) {
+    struct stat info;
+
+    if (lstat(socketpath.GetCString(), &info) == 0) {
+        // never replace anything but a socket, the path may be a typo
+        if (!S_ISSOCK(info.st_mode)) {
+            error = "it exists and isn't a socket";
+            return NULL;
+        }
+
+        // a socket someone answers on belongs to a running server
+        if (iostream* stream = Connect(socketpath)) {
+            delete stream;
+            error = "another server is listening on it";
+            return NULL;
+        }
+
+        // remove the stale socket from a previous server
+        unlink(socketpath.GetCString());
+    }
+
+    try {
+        return new opLocalListener(socketpath);
+    } catch (boost::system::system_error& e) {
+        error = e.what();
+        return NULL;
+    }
+}
+
+iostream* Accept(opLocalListener* listener) {
+    stream_protocol::iostream* stream = new stream_protocol::iostream;
+    boost::system::error_code error;
+
+#if BOOST_VERSION >= 106600
+    listener->acceptor.accept(stream->socket(), error);
+#else
+    listener->acceptor.accept(*stream->rdbuf(), error);
+#endif
+
+    if (error) {
+        delete stream;
+        return NULL;
+    }
+
+    return stream;
+}
+
+void Close(opLocalListener* listener) { delete listener; }
+
+iostream* Connect(const opString& socketpath) {
+    stream_protocol::iostream* stream =
+        new stream_protocol::iostream(
+            stream_protocol::endpoint(socketpath.GetString()));
+
+    if (!*stream) {
+        delete stream;
+        return NULL;
+    }
+
+    return stream;
+}
+
+#else
+
+// no local sockets on this platform (use '-server -')
+
+class opLocalListener {};
+
+opLocalListener* Listen(const opString& socketpath, opString& error) {
+    error = "local sockets aren't supported";
+    return NULL;
+}
+
+iostream* Accept(opLocalListener* listener) { return NULL; }
+
+void Close(opLocalListener* listener) {}
+
+iostream* Connect(const opString& socketpath) { return NULL; }
+
+#endif
+
+}  // namespace sockets
@@ -17,7 +17,7 @@
 /// opStringStream
 ///
 
-bool opStringStream::ForceComments = false;
+THREAD_LOCAL bool opStringStream::ForceComments = false;
 
 void opStringStream::EndLine() {
     if (ignorenewlines) return;
@@ -0,0 +1,97 @@
+///****************************************************************
+/// Copyright  2008 opGames LLC - All Rights Reserved
+///
+/// Authors: Kevin Depue & Lucas Ellis
+///
+/// File: SymbolTable.cpp
+/// Date: 10/17/2026
+///
+/// Description:
+///
+/// Interned identifier strings.
+///****************************************************************
+
+#include "opcpp/opcpp.h"
+
+///==========================================
+/// opSymbol
+///==========================================
+
+opArray<const opSymbol::SymbolEntry*> opSymbol::Slots;
+int opSymbol::Count = 0;
+boost::mutex opSymbol::Mutex;
+THREAD_LOCAL const opSymbol::SymbolEntry* opSymbol::Cache[CacheSize];
+
+opSymbol opSymbol::Intern(const char* text, int length) {
+    int hash = HashText(text, length);
+    const SymbolEntry*& cached =
+        Cache[(hash ^ (hash >> 10)) & (CacheSize - 1)];
+
+    if (!cached || !cached->Equals(text, length, hash))
+        cached = Find(text, length, hash);
+
+    return opSymbol(cached);
+}
+
+const opString& opSymbol::GetString() const {
+    static const opString empty;
+
+    return Entry ? Entry->String : empty;
+}
+
+// djb2, stopping at a nul like opString::Hash
+int opSymbol::HashText(const char* text, int length) {
+    int hash = 5381;
+
+    for (int i = 0; i < length && text[i]; i++)
+        hash = ((hash << 5) + hash) + text[i];
+
+    return hash;
+}
+
+// djb2's low bits are weak, mix the high ones in
+unsigned int opSymbol::FirstSlot(int hash) {
+    unsigned int slot = (unsigned int)hash * 0x9e3779b9u;
+
+    return slot ^ (slot >> 16);
+}
+
+const opSymbol::SymbolEntry* opSymbol::Find(const char* text, int length,
+                                            int hash) {
+    boost::mutex::scoped_lock lock(Mutex);
+
+    if (Count * 2 >= Slots.Size()) {
+        opArray<const SymbolEntry*> old;
+        old.Swap(Slots);
+
+        Slots.AddZeroed(old.IsEmpty() ? 4096 : old.Size() * 2);
+
+        unsigned int mask = Slots.Size() - 1;
+
+        for (int i = 0; i < old.Size(); i++) {
+            if (!old[i]) continue;
+
+            unsigned int slot = FirstSlot(old[i]->Hash);
+
+            while (Slots[(int)(slot & mask)]) slot++;
+
+            Slots[(int)(slot & mask)] = old[i];
+        }
+    }
+
+    unsigned int mask = Slots.Size() - 1;
+    unsigned int slot = FirstSlot(hash);
+
+    while (const SymbolEntry* entry = Slots[(int)(slot & mask)]) {
+        if (entry->Equals(text, length, hash)) return entry;
+
+        slot++;
+    }
+
+    const SymbolEntry* entry = new SymbolEntry(text, length, hash);
+
+    Slots[(int)(slot & mask)] = entry;
+    Count++;
+
+    return entry;
+}
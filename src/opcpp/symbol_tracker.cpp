@@ -18,15 +18,16 @@
 ///==========================================
 
 void opSymbolTracker::Register(OPMacroNode* innode) {
-    opString keystring = innode->GetSignature();
+    opMacroSignature key = innode->GetKey();
 
     // just to make sure we have newer opmacros replace already defined ones
     // we may want to allow some control of this behavior
-    OPMacrosTable.Erase(keystring);
-    OPMacrosTable.Insert(keystring, innode);
+    OPMacrosTable.Erase(key);
+    OPMacrosTable.Insert(key, innode);
 }
 
-OPMacroNode* opSymbolTracker::OPMacroRegistered(const opString& signature) {
+OPMacroNode* opSymbolTracker::OPMacroRegistered(
+    const opMacroSignature& signature) {
     OPMacroNode* result = NULL;
 
     OPMacrosTable.Find(signature, result);
@@ -16,4 +16,87 @@
 namespace timing {
 double opTimer::invtimerfrequency;
 unsigned long opTimer::timerstart;
+
+//
+// opTrace
+//
+
+bool opTrace::bEnabled = false;
+double opTrace::StartTime = 0;
+boost::mutex opTrace::EventsMutex;
+opArray<opTrace::Event> opTrace::Events;
+int opTrace::NumThreads = 0;
+THREAD_LOCAL int opTrace::Thread = 0;
+
+void opTrace::Start() {
+    bEnabled = true;
+    StartTime = opTimer::GetTimeSeconds();
+    Events.Clear();
+}
+
+void opTrace::Record(const opString& name, const char* category,
+                     double start, double end) {
+    boost::mutex::scoped_lock lock(EventsMutex);
+
+    // threads are numbered as they first record
+    if (!Thread) Thread = ++NumThreads;
+
+    Event event;
+    event.Name = name;
+    event.Category = category;
+    event.Start = start - StartTime;
+    event.Duration = end - start;
+    event.Thread = Thread;
+
+    Events.PushBack(event);
+}
+
+opString opTrace::Escape(const opString& s) {
+    opString escaped;
+
+    for (int i = 0; i < s.Length(); i++) {
+        char c = s[i];
+
+        if (c == '\\' || c == '"') {
+            escaped += '\\';
+            escaped += c;
+        } else if ((unsigned char)c < 0x20)
+            escaped += ' ';
+        else
+            escaped += c;
+    }
+
+    return escaped;
+}
+
+// writes the recorded spans in chrome trace event format (times in us)
+bool opTrace::Save(const opString& filename) {
+    boost::mutex::scoped_lock lock(EventsMutex);
+
+    std::ofstream o(filename.GetCString());
+
+    if (!o.is_open()) return false;
+
+    o << "{\"traceEvents\":[" << endl;
+
+    o << std::fixed << std::setprecision(1);
+
+    for (int i = 0; i < Events.Size(); i++) {
+        const Event& event = Events[i];
+
+        o << "{\"name\":\"" << Escape(event.Name).GetString()
+          << "\",\"cat\":\"" << event.Category
+          << "\",\"ph\":\"X\",\"ts\":" << event.Start * 1000000.0
+          << ",\"dur\":" << event.Duration * 1000000.0
+          << ",\"pid\":1,\"tid\":" << event.Thread << "}";
+
+        if (i + 1 < Events.Size()) o << ",";
+
+        o << endl;
+    }
+
+    o << "],\"displayTimeUnit\":\"ms\"}" << endl;
+
+    return !o.fail();
+}
 }  // end namespace timing
@@ -19,8 +19,8 @@
 ///
 
 opString opTokenMap::TokenToString[Tokens_MAX];
-opHashTable<opString, Token> opTokenMap::StringToToken;
-opHashTable<Token, opString> opTokenMap::TokenToDialectModifier;
+opPerfectHash<Token> opTokenMap::StringToToken;
+opString opTokenMap::TokenToDialectModifier[Tokens_MAX];
 opString opTokenNames::TokenNames[Tokens_MAX];
 
 namespace metaprogramming {
@@ -86,4 +86,13 @@ void InitTokens() {
     // I may have made this too complicated
     // possibly...but I don't think so
     InitializeTokenStrings<Tokens_MIN>::Exec();
+
+    // the keyword/operator strings are all registered now, and since
+    // they're fixed a failure here is a bug - every keyword would scan
+    // as an identifier, so don't go on
+    if (!opTokenMap::BuildLookup()) {
+        Log("error: couldn't build the keyword/operator lookup");
+        assert(0);
+        abort();
+    }
 }
@@ -18,6 +18,9 @@
 
 #define WIN32_LEAN_AND_MEAN
 #include <windows.h>
+#include <psapi.h>
+
+#pragma comment(lib, "psapi.lib")
 
 void errors::opLog::DebugLog(const opString& s) { OutputDebugString(s); }
 
@@ -40,6 +43,17 @@ bool opPlatform::ParseExeLocation(const opString& cmdarg) {
     return true;
 }
 
+// peak working set size
+long long opPlatform::GetPeakMemoryKb() {
+    PROCESS_MEMORY_COUNTERS counters;
+
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters,
+                              sizeof(counters)))
+        return 0;
+
+    return counters.PeakWorkingSetSize / 1024;
+}
+
 /*=== timing ===*/
 
 #include "opcpp/timer.h"
@@ -8,5 +8,9 @@ int main()
     std::cout << "\tm_transient_member" << test.m_transient_member << std::endl;
     std::cout << "\tm_native_member" << test.m_native_member << std::endl;
 
+    test::CrlfTest crlf;
+
+    std::cout << "\tm_sum" << crlf.m_sum << std::endl;
+
     return 0;
 }
@@ -0,0 +1,224 @@
+///****************************************************************
+/// Copyright  2008 opGames LLC - All Rights Reserved
+///
+/// Authors: Kevin Depue & Lucas Ellis
+///
+/// File: Generate.cpp
+/// Date: 10/17/2026
+///
+/// Description:
+///
+/// Writes a synthetic opC++ project for the benchmarks.
+///****************************************************************
+
+#include <stdlib.h>
+#include <string.h>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+using namespace std;
+
+// workload shape (see PrintUsage)
+struct Settings {
+    Settings()
+        : Files(16),
+          Classes(8),
+          Members(12),
+          Modifiers(1),
+          Macros(2),
+          IncludeDepth(2),
+          Output("project") {}
+
+    int Files;
+    int Classes;
+    int Members;
+    int Modifiers;
+    int Macros;
+    int IncludeDepth;
+    string Output;
+};
+
+static void PrintUsage() {
+    cout << "usage: generate [options]" << endl
+         << "\t-o <dir>            output directory (project)" << endl
+         << "\t-files <n>          code files (16)" << endl
+         << "\t-classes <n>        opclasses per file (8)" << endl
+         << "\t-members <n>        data members per class (12)" << endl
+         << "\t-modifiers <n>      data modifiers per member, 0-2 (1)" << endl
+         << "\t-macros <n>         opmacro expansions per class (2)" << endl
+         << "\t-include-depth <n>  opinclude chain length (2)" << endl;
+}
+
+static bool ParseArguments(int argc, char** argv, Settings& s) {
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 >= argc) return false;
+
+        const char* arg = argv[i];
+        const char* value = argv[++i];
+
+        if (!strcmp(arg, "-o"))
+            s.Output = value;
+        else if (!strcmp(arg, "-files"))
+            s.Files = atoi(value);
+        else if (!strcmp(arg, "-classes"))
+            s.Classes = atoi(value);
+        else if (!strcmp(arg, "-members"))
+            s.Members = atoi(value);
+        else if (!strcmp(arg, "-modifiers"))
+            s.Modifiers = atoi(value);
+        else if (!strcmp(arg, "-macros"))
+            s.Macros = atoi(value);
+        else if (!strcmp(arg, "-include-depth"))
+            s.IncludeDepth = atoi(value);
+        else
+            return false;
+    }
+
+    if (s.Modifiers > 2) s.Modifiers = 2;
+
+    // a second expansion for a member would redefine its getter
+    if (s.Macros > s.Members) s.Macros = s.Members;
+
+    return s.Files > 0 && s.Classes > 0 && s.Members > 0 && s.Modifiers >= 0 &&
+           s.Macros >= 0 && s.IncludeDepth >= 0;
+}
+
+static const char* MemberTypes[] = {"int", "float", "double", "bool"};
+static const char* MemberModifiers[] = {"transient", "native"};
+
+// the getter macro defined by an include level (or the file itself)
+static string MacroName(const Settings& s, int file, int index) {
+    ostringstream name;
+
+    if (s.IncludeDepth > 0 && index % 2 == 0)
+        name << "level" << (index / 2) % s.IncludeDepth << "_getter";
+    else
+        name << "file" << file << "_getter";
+
+    return name.str();
+}
+
+static void WriteMacro(ostream& o, const string& name) {
+    o << "opmacro " << name << "(type, name)" << endl
+      << "{" << endl
+      << "    type Get@name() const { return m_@name; }" << endl
+      << "}" << endl
+      << endl;
+}
+
+// include level i opincludes level i + 1
+static bool WriteInclude(const Settings& s, int level) {
+    ostringstream filename;
+    filename << s.Output << "/include/level" << level << ".oh";
+
+    ofstream o(filename.str().c_str());
+
+    if (!o.is_open()) return false;
+
+    if (level + 1 < s.IncludeDepth)
+        o << "opinclude \"level" << level + 1 << ".oh\"" << endl << endl;
+
+    ostringstream name;
+    name << "level" << level << "_getter";
+
+    WriteMacro(o, name.str());
+
+    o << "namespace level" << level << endl
+      << "{" << endl
+      << "    openum Kind" << endl
+      << "    {" << endl
+      << "        First," << endl
+      << "        Second = " << level + 2 << "," << endl
+      << "        Third" << endl
+      << "    };" << endl
+      << "}" << endl;
+
+    return true;
+}
+
+static void WriteClass(ostream& o, const Settings& s, int file, int c) {
+    o << "    opclass Class" << c;
+
+    if (c > 0) o << " : public Class" << c - 1;
+
+    o << endl
+      << "    {" << endl
+      << "    public:" << endl
+      << "        Class" << c << "() {}" << endl
+      << endl;
+
+    for (int m = 0; m < s.Members; m++) {
+        o << "        public";
+
+        for (int i = 0; i < s.Modifiers; i++)
+            o << " " << MemberModifiers[(m + i) % 2];
+
+        o << " " << MemberTypes[m % 4] << " m_Value" << c << "_" << m << ";"
+          << endl;
+    }
+
+    o << endl;
+
+    for (int i = 0; i < s.Macros; i++)
+        o << "        expand " << MacroName(s, file, i) << "("
+          << MemberTypes[i % 4] << ", Value" << c << "_" << i << ");" << endl;
+
+    o << endl
+      << "        virtual void Update(float dt) { m_Value" << c
+      << "_0 += (int)(dt * " << c + 1 << ".0f); }" << endl
+      << "    };" << endl
+      << endl;
+}
+
+static bool WriteFile(const Settings& s, int file) {
+    ostringstream filename;
+    filename << s.Output << "/src/file" << file << ".oh";
+
+    ofstream o(filename.str().c_str());
+
+    if (!o.is_open()) return false;
+
+    if (s.IncludeDepth > 0) o << "opinclude \"level0.oh\"" << endl << endl;
+
+    ostringstream name;
+    name << "file" << file << "_getter";
+
+    WriteMacro(o, name.str());
+
+    o << "namespace bench" << file << endl << "{" << endl;
+
+    for (int c = 0; c < s.Classes; c++) WriteClass(o, s, file, c);
+
+    o << "}" << endl;
+
+    return true;
+}
+
+int main(int argc, char** argv) {
+    Settings s;
+
+    if (!ParseArguments(argc, argv, s)) {
+        PrintUsage();
+        return 1;
+    }
+
+    string mkdir = "mkdir -p \"" + s.Output + "/src\" \"" + s.Output +
+                   "/include\"";
+
+    if (system(mkdir.c_str()) != 0) return 1;
+
+    for (int i = 0; i < s.IncludeDepth; i++)
+        if (!WriteInclude(s, i)) return 1;
+
+    for (int i = 0; i < s.Files; i++)
+        if (!WriteFile(s, i)) return 1;
+
+    cout << "generated " << s.Files << " files (" << s.Classes
+         << " classes, " << s.Members << " members, " << s.Modifiers
+         << " modifiers, " << s.Macros << " macros, include depth "
+         << s.IncludeDepth << ") in " << s.Output << endl;
+
+    return 0;
+}